@@ -101,13 +101,7 @@ ErrorType CCAECC::decode(FaultDomain *fd, CacheLine &errorBlk) {
 //------------------------------------------------------------------------------
 ErrorType DDR4QPC72b::decode(FaultDomain *fd, CacheLine &errorBlk) {
     // find appropriate CODEC
-    Codec *codec = NULL;
-    for (auto it = dataECC->configList.begin(); it != dataECC->configList.end(); it++) {
-        if (   (fd->getRetiredChipCount() <= it->maxDeviceRetirement)
-            && (fd->getRetiredPinCount() <= it->maxPinRetirement) ) {
-            codec = it->codec;
-        }
-    }
+    Codec *codec = dataECC->getCodec(fd);
     if (codec==NULL) { return SDC; }
 
     preprocess(fd);
@@ -165,13 +159,7 @@ ErrorType DDR4QPC72b::decode(FaultDomain *fd, CacheLine &errorBlk) {
 //------------------------------------------------------------------------------
 ErrorType AzulQPC72b::decode(FaultDomain *fd, CacheLine &errorBlk) {
     // find appropriate CODEC
-    Codec *codec = NULL;
-    for (auto it = dataECC->configList.begin(); it != dataECC->configList.end(); it++) {
-        if (   (fd->getRetiredChipCount() <= it->maxDeviceRetirement)
-            && (fd->getRetiredPinCount() <= it->maxPinRetirement) ) {
-            codec = it->codec;
-        }
-    }
+    Codec *codec = dataECC->getCodec(fd);
     if (codec==NULL) { return SDC; }
 
     preprocess(fd);
@@ -199,9 +187,9 @@ ErrorType AzulQPC72b::decode(FaultDomain *fd, CacheLine &errorBlk) {
         int burst_length = error_msb - error_lsb;
         unsigned checksum;
         if (burst_length<4) {   // always non-zero checksum
-            checksum = 1+rand()%15;
+            checksum = 1+randomGenerator.uniformInt(15);
         } else {
-            checksum = rand()%16;
+            checksum = randomGenerator.uniformInt(16);
         }
 
         xorSym(msg.getDataPtr(), 1,  0, (checksum>>0)&1);
@@ -260,13 +248,7 @@ ErrorType AzulQPC72b::decode(FaultDomain *fd, CacheLine &errorBlk) {
 //------------------------------------------------------------------------------
 ErrorType NickQPC72b::decode(FaultDomain *fd, CacheLine &errorBlk) {
     // find appropriate CODEC
-    Codec *codec = NULL;
-    for (auto it = dataECC->configList.begin(); it != dataECC->configList.end(); it++) {
-        if (   (fd->getRetiredChipCount() <= it->maxDeviceRetirement)
-            && (fd->getRetiredPinCount() <= it->maxPinRetirement) ) {
-            codec = it->codec;
-        }
-    }
+    Codec *codec = dataECC->getCodec(fd);
     if (codec==NULL) { return SDC; }
 
     preprocess(fd);
@@ -320,13 +302,7 @@ ErrorType NickQPC72b::decode(FaultDomain *fd, CacheLine &errorBlk) {
 //------------------------------------------------------------------------------
 ErrorType AIECCQPC72b::decode(FaultDomain *fd, CacheLine &errorBlk) {
     // find appropriate CODEC
-    Codec *codec = NULL;
-    for (auto it = dataECC->configList.begin(); it != dataECC->configList.end(); it++) {
-        if (   (fd->getRetiredChipCount() <= it->maxDeviceRetirement)
-            && (fd->getRetiredPinCount() <= it->maxPinRetirement) ) {
-            codec = it->codec;
-        }
-    }
+    Codec *codec = dataECC->getCodec(fd);
     if (codec==NULL) { return SDC; }
 
     preprocess(fd);
@@ -83,7 +83,7 @@ class QPCCR: public ECC {
         configList.push_back({0, 0, new RS<2, 8>("SPC-TPD\t17\t4\t", 68, 4, 1)});
     }
     ErrorType postprocess(FaultDomain *fd, ErrorType preResult) {
-        if (fd->retiredChipIDList.size()<1) {
+        if (fd->getRetiredChipCount()<1) {
             if (correctedPosSet.size() > 2) {
                 int chipPos = -1;
                 for (auto it = correctedPosSet.cbegin(); it != correctedPosSet.cend(); it++) {
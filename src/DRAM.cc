@@ -1,4 +1,5 @@
 #include "DRAM.hh"
+#include "Random.hh"
 
 long cur_cycle;
 
@@ -886,7 +887,7 @@ CCAErrorResult DDR4a::receive(std::bitset<CCA_SIZE>& cca) {
                 }
             }
             int burst_length = error_msb - error_lsb;
-            if ((burst_length<4)||(rand()%256!=0)) {
+            if ((burst_length<4)||(randomGenerator.uniformInt(256)!=0)) {
                 // 100% detection
                 if (ccaErrorInfo[type].isMDC && (type!=CCA_ERROR_WR2RD)) {
                     return CCA_DE_DECC_LATE;
@@ -938,7 +939,7 @@ CCAErrorResult DDR4a::check() {
                 }
             }
             int burst_length = error_msb - error_lsb;
-            if ((burst_length<4)||(rand()%256!=0)) {
+            if ((burst_length<4)||(randomGenerator.uniformInt(256)!=0)) {
                 // 100% detection
                 if (ccaErrorInfo[type].isMDC && (type!=CCA_ERROR_WR2RD)) {
                     return CCA_DE_DECC_LATE;
@@ -3,15 +3,110 @@
 #include <stdio.h>
 #include <assert.h>
 
+#include "Fault.hh"
 #include "FaultDomain.hh"
 #include "DomainGroup.hh"
 
-FaultDomain *DomainGroup::pickRandomFD() {
-    ErrorType result;
-    int posFD = rand() % FDList.size();
-    auto it = FDList.begin();
-    for (int i=0; i<posFD; i++) {
-        ++it;
+// event of the initial state of domain i: DOMAIN_EVENT+i
+// (above the arrival events, below the empty-lifetime skip stream)
+static const unsigned DOMAIN_EVENT = 0x80000000u;
+
+//------------------------------------------------------------------------------
+DomainGroup::~DomainGroup() {
+    for (size_t i=0; i<touchedFDs.size(); i++) {
+        delete touchedFDs[i];
+    }
+    for (size_t i=0; i<spareFDs.size(); i++) {
+        delete spareFDs[i];
+    }
+    for (size_t i=0; i<prototypes.size(); i++) {
+        delete prototypes[i];
+    }
+}
+
+void DomainGroup::setInherentFault(Fault *fault) {
+    inherentFault = fault;
+    for (size_t i=0; i<touchedFDs.size(); i++) {
+        touchedFDs[i]->setInherentFault(fault);
+    }
+    for (size_t i=0; i<spareFDs.size(); i++) {
+        spareFDs[i]->setInherentFault(fault);
+    }
+}
+
+void DomainGroup::setTypeBias(double bias) {
+    typeBias = bias;
+    for (size_t i=0; i<touchedFDs.size(); i++) {
+        touchedFDs[i]->faultRateInfo->setTypeBias(bias);
+    }
+    for (size_t i=0; i<spareFDs.size(); i++) {
+        spareFDs[i]->faultRateInfo->setTypeBias(bias);
+    }
+}
+
+void DomainGroup::setRateProfile(const std::string &prefix, const RateProfile *profile) {
+    rateProfiles.push_back(std::make_pair(prefix, profile));
+    for (size_t i=0; i<touchedFDs.size(); i++) {
+        touchedFDs[i]->faultRateInfo->setRateProfile(prefix, profile);
+    }
+    for (size_t i=0; i<spareFDs.size(); i++) {
+        spareFDs[i]->faultRateInfo->setRateProfile(prefix, profile);
+    }
+}
+
+//------------------------------------------------------------------------------
+FaultDomain *DomainGroup::getDomain(int domainID) {
+    assert((domainID>=0) && (domainID<domainCount));
+    auto it = FDMap.find(domainID);
+    if (it!=FDMap.end()) {
+        return it->second;
+    }
+
+    // materialize the domain (in its initial state)
+    FaultDomain *fd;
+    if (spareFDs.empty()) {
+        fd = createFD();
+        fd->setInherentFault(inherentFault);
+        fd->faultRateInfo->setTypeBias(typeBias);
+        for (size_t i=0; i<rateProfiles.size(); i++) {
+            fd->faultRateInfo->setRateProfile(rateProfiles[i].first, rateProfiles[i].second);
+        }
+    } else {
+        fd = spareFDs.back();
+        spareFDs.pop_back();
+    }
+    if ((inherentFault!=NULL) && (initialRetireECC!=NULL)) {
+        RandomGenerator savedGenerator = randomGenerator;
+        randomGenerator.startEvent(DOMAIN_EVENT+domainID);
+        fd->setInitialRetiredBlkCount(initialRetireECC);
+        randomGenerator = savedGenerator;
+    }
+    FDMap[domainID] = fd;
+    touchedIDs.push_back(domainID);
+    touchedFDs.push_back(fd);
+    return fd;
+}
+
+// the random draws of its construction do not disturb the current stream
+const Fault *DomainGroup::getPrototype(int typeID) {
+    if ((int) prototypes.size()<=typeID) {
+        prototypes.resize(typeID+1, NULL);
+    }
+    if (prototypes[typeID]==NULL) {
+        RandomGenerator savedGenerator = randomGenerator;
+        prototypes[typeID] = Fault::genRandomFault(typeID, getAnyFD());
+        randomGenerator = savedGenerator;
+    }
+    return prototypes[typeID];
+}
+
+// back to the initial state: only the touched domains have state to drop
+void DomainGroup::clear() {
+    for (size_t i=0; i<touchedFDs.size(); i++) {
+        touchedFDs[i]->clear();
+        FDMap.erase(touchedIDs[i]);
+        spareFDs.push_back(touchedFDs[i]);
     }
-    return *it;
+    touchedIDs.clear();
+    touchedFDs.clear();
 }
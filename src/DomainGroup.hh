@@ -2,43 +2,88 @@
 #define __DOMAIN_GROUP_HH__
 
 #include <list>
+#include <vector>
+#include <unordered_map>
 
 #include "common.hh"
 #include "FaultDomain.hh"
 
 //------------------------------------------------------------------------------
+// A group of identical fault domains, materialized lazily
+// - a domain gets FaultDomain state only when a fault lands on it, so that
+//   fleet-sized groups (10^5-10^6 DIMMs) cost only what a lifetime touches
+// - clear() recycles the touched domains; scrub()/clear() skip the rest
+// - initial retired blocks of an inherent fault are drawn per domain when it
+//   is materialized, from its own event of the current run
 class DomainGroup {     // Corresponds to a cluster
 public:
-    DomainGroup() {}
-    ~DomainGroup() {
-        for (auto it=FDList.begin(); it!=FDList.end(); ++it) {
-            delete *it;
-        }
-        FDList.clear();
-    }
+    DomainGroup(int _domainCount)
+    : domainCount(_domainCount), domainFaultRate(0.), inherentFault(NULL), typeBias(1.), initialRetireECC(NULL) {}
+    virtual ~DomainGroup();
+
+    double getFaultRate() { return domainCount * domainFaultRate; }
+    // expected fault count over [0, hr] (getFaultRate()*hr when constant)
+    double getHazard(double hr) { return domainCount * getAnyFD()->getHazard(hr); }
+    bool isTimeVarying() { return getAnyFD()->faultRateInfo->isTimeVarying(); }
+    int getDomainCount() { return domainCount; }
+    void setInherentFault(Fault *fault);
+    void setTypeBias(double bias);
+    void setRateProfile(const std::string &prefix, const RateProfile *profile);
+    void setInitialRetiredBlkCount(ECC *ecc) { initialRetireECC = ecc; }
 
-    double getFaultRate() { return (FDList.size()==0) ? 0 : FDList.size() * FDList.front()->getFaultRate(); }
-    void setInherentFault(Fault *fault) { for (auto it=FDList.begin(); it!=FDList.end(); ++it) { (*it)->setInherentFault(fault); } }
-    void setInitialRetiredBlkCount(ECC *ecc) { for (auto it=FDList.begin(); it!=FDList.end(); ++it) { (*it)->setInitialRetiredBlkCount(ecc); } }
+    FaultDomain *pickRandomFD() { return getDomain(pickRandomDomainID()); }
+    int pickRandomDomainID() { return randomGenerator.uniformInt(domainCount); }
+    // a fault of a type on the geometry of the domains (fault log replay)
+    const Fault *getPrototype(int typeID);
 
-    FaultDomain *pickRandomFD();
+    void scrub() { for (size_t i=0; i<touchedFDs.size(); i++) { touchedFDs[i]->scrub(); } }
+    void clear();
+    FaultDomain *getFD() { return getDomain(0); }
+    FaultDomain *getFD(int domainID) { return getDomain(domainID); }
+    // the domains are identical: any of them for the rates and geometry
+    // (without materializing a domain)
+    FaultDomain *getAnyFD() { return spareFDs.empty() ? touchedFDs[0] : spareFDs[0]; }
 
-    void scrub() { for (auto it=FDList.begin(); it!=FDList.end(); ++it) { (*it)->scrub(); } }
-    void clear() { for (auto it=FDList.begin(); it!=FDList.end(); ++it) { (*it)->clear(); } }
-    FaultDomain *getFD() { return FDList.front(); }
+protected:
+    virtual FaultDomain *createFD() = 0;
+    FaultDomain *getDomain(int domainID);
 
 protected:
-    std::list<FaultDomain *> FDList;
+    int domainCount;
+    double domainFaultRate;
+
+    std::unordered_map<int, FaultDomain *> FDMap;   // materialized domains
+    std::vector<int> touchedIDs;                    // their IDs
+    std::vector<FaultDomain *> touchedFDs;          // and domains
+    std::vector<FaultDomain *> spareFDs;            // recycled domains
+    std::vector<Fault *> prototypes;                // by type ID (built on demand)
+
+    Fault *inherentFault;
+    double typeBias;
+    std::vector<std::pair<std::string, const RateProfile *>> rateProfiles;
+    ECC *initialRetireECC;
 };
 
 //----------------------------------------------------------
 class DomainGroupDDR : public DomainGroup {
 public:
-    DomainGroupDDR(int domainsPerGroup, int ranksPerDomain, int devicesPerRank, int pinsPerDevice, int blkHeight) {
-        for (int i=0; i<domainsPerGroup; i++) {
-            FDList.push_back(new FaultDomainDDR(ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight));
-        }
+    DomainGroupDDR(int domainsPerGroup, int _ranksPerDomain, int _devicesPerRank, int _pinsPerDevice, int _blkHeight)
+    : DomainGroup(domainsPerGroup), ranksPerDomain(_ranksPerDomain), devicesPerRank(_devicesPerRank),
+      pinsPerDevice(_pinsPerDevice), blkHeight(_blkHeight) {
+        spareFDs.push_back(createFD());
+        domainFaultRate = spareFDs.back()->getFaultRate();
     }
+
+protected:
+    // the domains share the fault rates of the group
+    FaultDomain *createFD() { return new FaultDomain(ranksPerDomain, devicesPerRank, pinsPerDevice, blkHeight, &faultRateInfo); }
+
+protected:
+    DefaultFaultRateInfo faultRateInfo;
+    int ranksPerDomain;
+    int devicesPerRank;
+    int pinsPerDevice;
+    int blkHeight;
 };
 
 #endif /* __DOMAIN_GROUP_HH__ */
@@ -7,8 +7,6 @@
 #include "hsiao.hh"
 #include "rs.hh"
 
-extern std::default_random_engine randomGenerator;
-
 //------------------------------------------------------------------------------
 ErrorType worse2ErrorType(ErrorType a, ErrorType b) {
     //if ((a==SDC) || (b==SDC)) {
@@ -36,16 +34,30 @@ ErrorType ECC::decode(FaultDomain *fd, CacheLine &errorBlk) {
     return result;
 }
 
-ErrorType ECC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
-    // find appropriate CODEC
-    Codec *codec = NULL;
-    for (auto it = configList.begin(); it != configList.end(); it++) {
-        if (   (fd->getRetiredChipCount() <= it->maxDeviceRetirement)
-            && (fd->getRetiredPinCount() <= it->maxPinRetirement) ) {
-            codec = it->codec;
-            //assert((codec->getBitN()%errorBlk.getChannelWidth())==0);
+// the last config that tolerates the retired chips and pins; retirement
+// changes rarely, so configList is walked again only when the counts differ
+// from those of the previous decode
+Codec *ECC::getCodec(FaultDomain *fd) {
+    int chipCount = fd->getRetiredChipCount();
+    int pinCount = fd->getRetiredPinCount();
+    if ((chipCount!=codecChipCount) || (pinCount!=codecPinCount)) {
+        codecChipCount = chipCount;
+        codecPinCount = pinCount;
+        activeCodec = NULL;
+        for (auto it = configList.begin(); it != configList.end(); it++) {
+            if (   (chipCount <= it->maxDeviceRetirement)
+                && (pinCount <= it->maxPinRetirement) ) {
+                activeCodec = it->codec;
+                //assert((codec->getBitN()%errorBlk.getChannelWidth())==0);
+            }
         }
     }
+    return activeCodec;
+}
+
+ErrorType ECC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
+    // find appropriate CODEC
+    Codec *codec = getCodec(fd);
     if (codec==NULL) { if (errorBlk.isZero()) return NE; else return SDC; }
 
     ECCWord msg = {codec->getBitN(), codec->getBitK()};
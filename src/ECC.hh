@@ -25,11 +25,15 @@ public:
     ECC(ECCLayout _layout) : ECC(_layout, false, false, 0) {}
     ECC(ECCLayout _layout, bool _doPostprocess) : ECC(_layout, _doPostprocess, false, 0) {}
     ECC(ECCLayout _layout, bool _doPostprocess, bool _doRetire, int _maxRetiredBlkCount)
-    : layout(_layout), doPostprocess(_doPostprocess), doRetire(_doRetire), maxRetiredBlkCount(_maxRetiredBlkCount) {}
+    : layout(_layout), doPostprocess(_doPostprocess), doRetire(_doRetire), maxRetiredBlkCount(_maxRetiredBlkCount),
+      codecChipCount(-1), codecPinCount(-1), activeCodec(NULL) {}
+    virtual ~ECC() {}
 
     // decoding
     ErrorType decode(FaultDomain *fd, CacheLine &blk);
     virtual ErrorType decodeInternal(FaultDomain *fd, CacheLine &blk);
+    // the codec for the retirement state of fd (NULL: none tolerates it)
+    Codec *getCodec(FaultDomain *fd);
     virtual ErrorType postprocess(FaultDomain *fd, ErrorType preResult) {
         // no post-processing
         return preResult;
@@ -61,6 +65,11 @@ protected:
     unsigned long long maxRetiredBlkCount;
 
     std::set<int> correctedPosSet;
+
+    // configList resolved for the retired chip/pin counts of the last decode
+    int codecChipCount;
+    int codecPinCount;
+    Codec *activeCodec;
 };
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,51 @@
+#ifndef __EVENT_QUEUE_HH__
+#define __EVENT_QUEUE_HH__
+
+#include <stddef.h>
+#include <vector>
+#include <algorithm>
+
+class FaultDomain;
+
+//------------------------------------------------------------------------------
+// Timestamped events of a system lifetime
+// - events at the same time run in type order (e.g. a scrub completing at
+//   the arrival time of a fault goes first)
+// - a new policy adds its type here and its handler to the event loop
+enum SimEventType {
+    SIM_SCRUB,      // scrub completion of a domain (fd)
+    SIM_ARRIVAL,    // fault arrival (the domain is picked when it runs)
+    SIM_HORIZON,    // end of the simulated lifetime
+};
+
+struct SimEvent {
+    double hr;
+    SimEventType type;
+    FaultDomain *fd;
+};
+
+//------------------------------------------------------------------------------
+// min-heap of events (the vector is kept across lifetimes)
+class EventQueue {
+public:
+    void clear() { heap.clear(); }
+    bool empty() const { return heap.empty(); }
+    void push(double hr, SimEventType type, FaultDomain *fd = NULL) {
+        SimEvent event = {hr, type, fd};
+        heap.push_back(event);
+        std::push_heap(heap.begin(), heap.end(), isLater);
+    }
+    SimEvent pop() {
+        std::pop_heap(heap.begin(), heap.end(), isLater);
+        SimEvent event = heap.back();
+        heap.pop_back();
+        return event;
+    }
+protected:
+    static bool isLater(const SimEvent &a, const SimEvent &b) {
+        return (a.hr > b.hr) || ((a.hr==b.hr) && (a.type > b.type));
+    }
+    std::vector<SimEvent> heap;
+};
+
+#endif /* __EVENT_QUEUE_HH__ */
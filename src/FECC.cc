@@ -42,7 +42,7 @@ bool FrugalECC64b::decodeEF(CacheLine &errorBlk, int& origCase, int& newCase) {
                  |(errorBlk.getBit( 8)<<1)
                  |(errorBlk.getBit( 0)<<0);
 
-    double randValue = drand48();
+    double randValue = randomGenerator.uniformReal();
     if (randValue > 0.9) {          // 0. uncompressed
         origCase = 0;
         // 0, 0, 0, 0, x
@@ -100,7 +100,7 @@ ErrorType FrugalECC64b::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         } else {
             // fill 64~72 bytes with random data.
             for (int i=64; i<73; i++) {
-                msg.setSymbol(8, i, rand()%0x100);
+                msg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 
@@ -117,7 +117,7 @@ ErrorType FrugalECC64b::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         if (origCase!=1) {
             // fill 56~63 bytes (ECC) with random data.
             for (int i=56; i<64; i++) {
-                msg.setSymbol(8, i, rand()%0x100);
+                msg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 
@@ -134,7 +134,7 @@ ErrorType FrugalECC64b::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         if (origCase==0) {
             // fill 60~63 bytes (ECC) with random data.
             for (int i=60; i<64; i++) {
-                msg.invSymbol(8, i, rand()%0x100);                    
+                msg.invSymbol(8, i, randomGenerator.uniformInt(0x100));                    
             }
         }
 
@@ -156,7 +156,7 @@ ErrorType FrugalECC64b::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
             if (origCase!=2) {
                 // fill 64~68 bytes (ECC) with random data.
                 for (int i=64; i<68; i++) {
-                    msg2.setSymbol(8, i, rand()%0x100);
+                    msg2.setSymbol(8, i, randomGenerator.uniformInt(0x100));
                 }
             }
 
@@ -195,7 +195,7 @@ bool FrugalECC64bNoEFP::decodeEF(CacheLine &errorBlk, int& origCase, int& newCas
     int errorEF = (errorBlk.getBit(8)<<1)
                  |(errorBlk.getBit(0)<<0);
 
-    double randValue = drand48();
+    double randValue = randomGenerator.uniformReal();
     if (randValue > 0.9) {          // 0. uncompressed
         origCase = 0;
         // 0, x
@@ -242,7 +242,7 @@ bool FrugalECC64b2::decodeEF(CacheLine &errorBlk, int& origCase, int& newCase) {
                  |(errorBlk.getBit(8)<<1)
                  |(errorBlk.getBit(0)<<0);
 
-    double randValue = drand48();
+    double randValue = randomGenerator.uniformReal();
     if (randValue > 0.9) {          // 0. uncompressed
         origCase = 0;
         // 0, 0, 0
@@ -292,7 +292,7 @@ ErrorType FrugalECC64b2::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         } else {
             // fill 64~72 bytes with random data.
             for (int i=64; i<69; i++) {
-                msg.setSymbol(8, i, rand()%0x100);
+                msg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 
@@ -309,7 +309,7 @@ ErrorType FrugalECC64b2::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         if (origCase!=1) {
             // fill 56~63 bytes (ECC) with random data.
             for (int i=60; i<64; i++) {
-                msg.setSymbol(8, i, rand()%0x100);
+                msg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 
@@ -351,7 +351,7 @@ bool FrugalECC64b3::decodeEF(CacheLine &errorBlk, int& origCase, int& newCase) {
                  |(errorBlk.getBit( 4)<<1)
                  |(errorBlk.getBit( 0)<<0);
 
-    double randValue = drand48();
+    double randValue = randomGenerator.uniformReal();
     if (randValue > 0.9) {          // 0. uncompressed
         origCase = 0;
         // 0, 0, 0, 0, 0, 0, x
@@ -409,7 +409,7 @@ ErrorType FrugalECC64b3::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         } else {
             // fill 64~80 bytes with random data.
             for (int i=64; i<81; i++) {
-                msg.setSymbol(8, i, rand()%0x100);
+                msg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 
@@ -426,7 +426,7 @@ ErrorType FrugalECC64b3::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         if (origCase!=1) {
             // fill 48~63 bytes (ECC) with random data.
             for (int i=48; i<64; i++) {
-                msg.setSymbol(8, i, rand()%0x100);
+                msg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 
@@ -443,7 +443,7 @@ ErrorType FrugalECC64b3::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
         if (origCase==0) {
             // fill 60~63 bytes (ECC) with random data.
             for (int i=56; i<64; i++) {
-                msg.setSymbol(8, i, rand()%0x100);
+                msg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 
@@ -465,7 +465,7 @@ ErrorType FrugalECC64b3::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
             if (origCase!=2) {
                 // fill 64~71 bytes (ECC) with random data.
                 for (int i=64; i<72; i++) {
-                    msg2.setSymbol(8, i, rand()%0x100);
+                    msg2.setSymbol(8, i, randomGenerator.uniformInt(0x100));
                 }
             }
 
@@ -504,7 +504,7 @@ bool FrugalECC72bOPC::decodeEF(CacheLine &errorBlk, int& origCase, int& newCase)
                  |(errorBlk.getBit( 8)<<1)
                  |(errorBlk.getBit( 0)<<0);
 
-    double randValue = drand48();
+    double randValue = randomGenerator.uniformReal();
     if (randValue > 0.9) {          // 0. uncompressed
         origCase = 0;
         // 0, 0, 0, 0, x
@@ -563,7 +563,7 @@ ErrorType FrugalECC72bOPC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk)
         } else {
             // fill 72~80 bytes with random data.
             for (int i=72; i<81; i++) {
-                msg.setSymbol(8, i, rand()%0x100);
+                msg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 
@@ -580,7 +580,7 @@ ErrorType FrugalECC72bOPC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk)
         if (origCase!=1) {
             // fill 56~71 bytes (ECC) with random data.
             for (int i=56; i<72; i++) {
-                msg.setSymbol(8, i, rand()%0x100);
+                msg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 
@@ -597,7 +597,7 @@ ErrorType FrugalECC72bOPC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk)
         if (origCase==0) {
             // fill 56~71 bytes (ECC) with random data.
             for (int i=64; i<72; i++) {
-                msg.invSymbol(8, i, rand()%0x100);
+                msg.invSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 
@@ -619,7 +619,7 @@ ErrorType FrugalECC72bOPC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk)
             if (origCase!=2) {
                 // fill 72~80 bytes (ECC) with random data.
                 for (int i=72; i<80; i++) {
-                    msg2.invSymbol(8, i, rand()%0x100);
+                    msg2.invSymbol(8, i, randomGenerator.uniformInt(0x100));
                 }
             }
 
@@ -658,7 +658,7 @@ bool FrugalECC72bNoEFP::decodeEF(CacheLine &errorBlk, int& origCase, int& newCas
     int errorEF = (errorBlk.getBit(8)<<1)
                  |(errorBlk.getBit(0)<<0);
 
-    double randValue = drand48();
+    double randValue = randomGenerator.uniformReal();
     if (randValue > 0.9) {          // 0. uncompressed
         origCase = 0;
         // 0, x
@@ -727,7 +727,7 @@ ErrorType FrugalECC64bMultix8::decodeInternal(FaultDomain *fd, CacheLine &errorB
         } else {
             // fill 64~80 bytes with random data.
             for (int i=8; i<10; i++) {
-                msg.setSymbol(16, i, rand()%0x10000);
+                msg.setSymbol(16, i, randomGenerator.uniformInt(0x10000));
             }
         }
 
@@ -754,16 +754,16 @@ ErrorType FrugalECC64bMultix8::decodeInternal(FaultDomain *fd, CacheLine &errorB
                         uint32_t errorChecksum = 0;
 
                         for (int j=0; j<256; j++) {
-                            uint16_t data = rand() % 0x10000;
+                            uint16_t data = randomGenerator.uniformInt(0x10000);
                             uint16_t error;
                             if (j==0) {
                                 error = decoded.getSymbol(16, (*it)->getChipID());
                             } else {
                                 if (!(*it)->getIsSingleDQ()) {
-                                    error = rand() % 0x10000;
+                                    error = randomGenerator.uniformInt(0x10000);
                                 } else {
                                     int pinLoc = (*it)->getPinID()%8;
-                                    error = ((rand()%2) << pinLoc) | (rand()%2 << (pinLoc+8));
+                                    error = (randomGenerator.uniformInt(2) << pinLoc) | (randomGenerator.uniformInt(2) << (pinLoc+8));
                                 }
                             }
                             origChecksum += data;
@@ -810,7 +810,7 @@ ErrorType FrugalECC64bMultix8::decodeInternal(FaultDomain *fd, CacheLine &errorB
         if (origCase!=1) {
             // fill 48~63 bytes (ECC) with random data.
             for (int i=56; i<64; i++) {
-                msg.setSymbol(8, i, rand()%0x100);
+                msg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
             }
         }
 */
@@ -826,7 +826,7 @@ ErrorType FrugalECC64bMultix8::decodeInternal(FaultDomain *fd, CacheLine &errorB
 
         if (origCase!=1) {
             // fill last chip with random data.
-            msg.setSymbol(16, 7, rand()%0x10000);
+            msg.setSymbol(16, 7, randomGenerator.uniformInt(0x10000));
         }
 
         if (msg.isZero()) {        // error-free region of a block -> skip
@@ -853,16 +853,16 @@ ErrorType FrugalECC64bMultix8::decodeInternal(FaultDomain *fd, CacheLine &errorB
                         uint32_t errorChecksum = 0;
 
                         for (int j=0; j<256; j++) {
-                            uint16_t data = rand() % 0x10000;
+                            uint16_t data = randomGenerator.uniformInt(0x10000);
                             uint16_t error;
                             if (j==0) {
                                 error = decoded.getSymbol(16, (*it)->getChipID());
                             } else {
                                 if (!(*it)->getIsSingleDQ()) {
-                                    error = rand() % 0x10000;
+                                    error = randomGenerator.uniformInt(0x10000);
                                 } else {
                                     int pinLoc = (*it)->getPinID()%8;
-                                    error = ((rand()%2) << pinLoc) | (rand()%2 << (pinLoc+8));
+                                    error = (randomGenerator.uniformInt(2) << pinLoc) | (randomGenerator.uniformInt(2) << (pinLoc+8));
                                 }
                             }
                             origChecksum += data;
@@ -933,7 +933,7 @@ bool FrugalECC64bMultix8::decodeEF(CacheLine &errorBlk, int& origCase, int& newC
                  |(errorBlk.getBit(24)<<1)
                  |(errorBlk.getBit(24)<<0);
 
-    double randValue = drand48();
+    double randValue = randomGenerator.uniformReal();
     if (randValue > 0.9) {          // 0. uncompressed
         origCase = 0;
         // 1, 1, 1, 0, 0
@@ -1009,7 +1009,7 @@ ErrorType FrugalECC64bMultix4::decodeInternal(FaultDomain *fd, CacheLine &errorB
         } else {
             // fill 64~80 bytes with random data.
             for (int i=16; i<18; i++) {
-                msg.setSymbol(16, i, rand()%0x10000);
+                msg.setSymbol(16, i, randomGenerator.uniformInt(0x10000));
             }
         }
 
@@ -1036,16 +1036,16 @@ ErrorType FrugalECC64bMultix4::decodeInternal(FaultDomain *fd, CacheLine &errorB
                         uint32_t errorChecksum = 0;
 
                         for (int j=0; j<256; j++) {
-                            uint16_t data = rand() % 0x10000;
+                            uint16_t data = randomGenerator.uniformInt(0x10000);
                             uint16_t error;
                             if (j==0) {
                                 error = decoded.getSymbol(16, (*it)->getChipID());
                             } else {
                                 if (!(*it)->getIsSingleDQ()) {
-                                    error = rand() % 0x10000;
+                                    error = randomGenerator.uniformInt(0x10000);
                                 } else {
                                     int pinLoc = (*it)->getPinID()%8;
-                                    error = ((rand()%2) << pinLoc) | (rand()%2 << (pinLoc+8));
+                                    error = (randomGenerator.uniformInt(2) << pinLoc) | (randomGenerator.uniformInt(2) << (pinLoc+8));
                                 }
                             }
                             origChecksum += data;
@@ -1100,7 +1100,7 @@ ErrorType FrugalECC64bMultix4::decodeInternal(FaultDomain *fd, CacheLine &errorB
     
             if (origCase!=1) {
                 // fill last chip with random data.
-                msg.setSymbol(16, 15, rand()%0x10000);
+                msg.setSymbol(16, 15, randomGenerator.uniformInt(0x10000));
             }
     
             if (msg.isZero()) {        // error-free region of a block -> skip
@@ -1126,16 +1126,16 @@ ErrorType FrugalECC64bMultix4::decodeInternal(FaultDomain *fd, CacheLine &errorB
                             uint32_t errorChecksum = 0;
     
                             for (int j=0; j<256; j++) {
-                                uint16_t data = rand() % 0x10000;
+                                uint16_t data = randomGenerator.uniformInt(0x10000);
                                 uint16_t error;
                                 if (j==0) {
                                     error = decoded.getSymbol(16, (*it)->getChipID());
                                 } else {
                                     if (!(*it)->getIsSingleDQ()) {
-                                        error = rand() % 0x10000;
+                                        error = randomGenerator.uniformInt(0x10000);
                                     } else {
                                         int pinLoc = (*it)->getPinID()%8;
-                                        error = ((rand()%2) << pinLoc) | (rand()%2 << (pinLoc+8));
+                                        error = (randomGenerator.uniformInt(2) << pinLoc) | (randomGenerator.uniformInt(2) << (pinLoc+8));
                                     }
                                 }
                                 origChecksum += data;
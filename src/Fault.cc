@@ -7,23 +7,22 @@
 #include <string.h>
 #include <stdio.h>
 #include <iostream>
+#include <new>
+#include <algorithm>
 
 #include "common.hh"
 #include "Config.hh"
 #include "Fault.hh"
 
 //----------------------------------------------------------
-std::default_random_engine randomGenerator;
+Fault::Fault(const char *_name)
+: fd(NULL), name(_name), typeID(-1), mask(SBIT_MASK), isInherent(true), isTransient(PERMANENT), numDQ(1), isSingleBeat(SINGLE_BEAT), isMultiColumn(SINGLE_COLUMN), isMultiRow(SINGLE_ROW), isChannel(NO_CHANNEL), affectedBlkCount(0) {}
 
-//----------------------------------------------------------
-Fault::Fault(std::string _name)
-: name(_name), fd(NULL), mask(SBIT_MASK), isInherent(true), isTransient(PERMANENT), numDQ(1), isSingleBeat(SINGLE_BEAT), isMultiRow(SINGLE_ROW), isMultiColumn(SINGLE_COLUMN), isChannel(NO_CHANNEL), affectedBlkCount(0) {}
-
-Fault::Fault(FaultDomain *_fd, std::string _name, ADDR _mask, bool _isInherent, bool _isTransient, int _numDQ, bool _isSingleBeat, bool _isMultiRow, bool _isMultiColumn, bool _isChannel, unsigned long long _affectedBlkCount)
-: fd(_fd), name(_name), mask(_mask), isInherent(_isInherent), isTransient(_isTransient), numDQ(_numDQ), isSingleBeat(_isSingleBeat), isMultiRow(_isMultiRow), isMultiColumn(_isMultiColumn), isChannel(_isChannel), affectedBlkCount(_affectedBlkCount) {
+Fault::Fault(FaultDomain *_fd, const char *_name, ADDR _mask, bool _isInherent, bool _isTransient, int _numDQ, bool _isSingleBeat, bool _isMultiRow, bool _isMultiColumn, bool _isChannel, unsigned long long _affectedBlkCount)
+: fd(_fd), name(_name), typeID(-1), mask(_mask), isInherent(_isInherent), isTransient(_isTransient), numDQ(_numDQ), isSingleBeat(_isSingleBeat), isMultiColumn(_isMultiColumn), isMultiRow(_isMultiRow), isChannel(_isChannel), affectedBlkCount(_affectedBlkCount) {
     if (isSingleBeat) {
         // start = end, count = 1
-        beatStart = rand()%fd->getBeatHeight();
+        beatStart = randomGenerator.uniformInt(fd->getBeatHeight());
         beatEnd = beatStart;
         beatCount = 1;
     } else {
@@ -31,7 +30,7 @@ Fault::Fault(FaultDomain *_fd, std::string _name, ADDR _mask, bool _isInherent,
         beatEnd = fd->getBeatHeight()-1;
         beatCount = fd->getBeatHeight();
     }
-    chipPos = rand() % fd->getChannelWidth() / fd->getChipWidth();
+    chipPos = randomGenerator.uniformInt(fd->getChannelWidth()) / fd->getChipWidth();
     for (int i=0; i<numDQ; i++) {
         if (numDQ==fd->getChipWidth()) {
             pinPos[i] = chipPos * fd->getChipWidth() + i;
@@ -39,7 +38,7 @@ Fault::Fault(FaultDomain *_fd, std::string _name, ADDR _mask, bool _isInherent,
             bool isConflict;
             int pin;
             do {
-                pin = rand() % fd->getChipWidth() + chipPos*fd->getChipWidth();
+                pin = randomGenerator.uniformInt(fd->getChipWidth()) + chipPos*fd->getChipWidth();
                 isConflict = false;
                 for (int j=0; j<i; j++) {
                     if (pinPos[j]==pin) {
@@ -50,193 +49,246 @@ Fault::Fault(FaultDomain *_fd, std::string _name, ADDR _mask, bool _isInherent,
             pinPos[i] = pin;
         }
     }
-    addr = RAND_MAX*((ADDR)rand()) + rand();   // 64-bit
+    addr = randomGenerator.next64();   // 64-bit
     cellFaultRate = .0;
 }
 
-Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
-    if (type=="b") {
-        return new SingleBitFault(fd, false);
-    } else if (type=="w") {
-        return new SingleWordFault(fd, false, fd->getChipWidth());
-    } else if (type=="p") {
-        return new SinglePinFault(fd, false);
-    } else if (type=="c") {
-        return new SingleChipFault(fd, false, fd->getChipWidth());
-    } else if (type=="r") {
-        return new ChannelFault(fd, false);
-    } else if (type=="i3") {
-        return new InherentFault(fd, 1e-3);
-    } else if (type=="i4") {
-        return new InherentFault(fd, 1e-4);
-    } else if (type=="i5") {
-        return new InherentFault(fd, 1e-5);
-    } else if (type=="i6") {
-        return new InherentFault(fd, 1e-6);
-    } else if (type=="i7") {
-        return new InherentFault(fd, 1e-7);
-    } else if (type=="i8") {
-        return new InherentFault(fd, 1e-8);
-    } else if (type=="i9") {
-        return new InherentFault(fd, 1e-9);
-    } else if (type=="i10") {
-        return new InherentFault(fd, 1e-10);
-    } else if (type=="i3-1") {
-        return new InherentFault2(fd, 1e-3, 1);
-    } else if (type=="i4-1") {
-        return new InherentFault2(fd, 1e-4, 1);
-    } else if (type=="i5-1") {
-        return new InherentFault2(fd, 1e-5, 1);
-    } else if (type=="i6-1") {
-        return new InherentFault2(fd, 1e-6, 1);
-    } else if (type=="i7-1") {
-        return new InherentFault2(fd, 1e-7, 1);
-    } else if (type=="i8-1") {
-        return new InherentFault2(fd, 1e-8, 1);
-    } else if (type=="i9-1") {
-        return new InherentFault2(fd, 1e-9, 1);
-    } else if (type=="i10-1") {
-        return new InherentFault2(fd, 1e-10, 1);
-    } else if (type=="i3-2") {
-        return new InherentFault2(fd, 1e-3, 2);
-    } else if (type=="i4-2") {
-        return new InherentFault2(fd, 1e-4, 2);
-    } else if (type=="i5-2") {
-        return new InherentFault2(fd, 1e-5, 2);
-    } else if (type=="i6-2") {
-        return new InherentFault2(fd, 1e-6, 2);
-    } else if (type=="i7-2") {
-        return new InherentFault2(fd, 1e-7, 2);
-    } else if (type=="i8-2") {
-        return new InherentFault2(fd, 1e-8, 2);
-    } else if (type=="i9-2") {
-        return new InherentFault2(fd, 1e-9, 2);
-    } else if (type=="i10-2") {
-        return new InherentFault2(fd, 1e-10, 2);
-    } else if (type=="sbit-t") {
-        return new SingleBitFault(fd, true);
-    } else if (type=="sbit-p") {
-        return new SingleBitFault(fd, false);
-    } else if (type=="sword-2p-t") {
-        return new SingleWordFault(fd, true, 2);
-    } else if (type=="sword-2p-p") {
-        return new SingleWordFault(fd, false, 2);
-    } else if (type=="sword-3p-t") {
-        return new SingleWordFault(fd, true, 3);
-    } else if (type=="sword-3p-p") {
-        return new SingleWordFault(fd, false, 3);
-    } else if (type=="sword-4p-t") {
-        return new SingleWordFault(fd, true, 4);
-    } else if (type=="sword-4p-p") {
-        return new SingleWordFault(fd, false, 4);
-    } else if (type=="sword-np-t") {
-        return new SingleWordFault(fd, true, fd->getChipWidth());
-    } else if (type=="sword-np-p") {
-        return new SingleWordFault(fd, false, fd->getChipWidth());
-    } else if (type=="scol-1p-t") {
-        return new SingleColumnFault(fd, true, 1);
-    } else if (type=="scol-1p-p") {
-        return new SingleColumnFault(fd, false, 1);
-    } else if (type=="scol-2p-t") {
-        return new SingleColumnFault(fd, true, 2);
-    } else if (type=="scol-2p-p") {
-        return new SingleColumnFault(fd, false, 2);
-    } else if (type=="scol-3p-t") {
-        return new SingleColumnFault(fd, true, 3);
-    } else if (type=="scol-3p-p") {
-        return new SingleColumnFault(fd, false, 3);
-    } else if (type=="scol-4p-t") {
-        return new SingleColumnFault(fd, true, 4);
-    } else if (type=="scol-4p-p") {
-        return new SingleColumnFault(fd, false, 4);
-    } else if (type=="scol-np-t") {
-        return new SingleColumnFault(fd, true, fd->getChipWidth());
-    } else if (type=="scol-np-p") {
-        return new SingleColumnFault(fd, false, fd->getChipWidth());
-    } else if (type=="srow-1p-t") {
-        return new SingleRowFault(fd, true, 1);
-    } else if (type=="srow-1p-p") {
-        return new SingleRowFault(fd, false, 1);
-    } else if (type=="srow-2p-t") {
-        return new SingleRowFault(fd, true, 2);
-    } else if (type=="srow-2p-p") {
-        return new SingleRowFault(fd, false, 2);
-    } else if (type=="srow-3p-t") {
-        return new SingleRowFault(fd, true, 3);
-    } else if (type=="srow-3p-p") {
-        return new SingleRowFault(fd, false, 3);
-    } else if (type=="srow-4p-t") {
-        return new SingleRowFault(fd, true, 4);
-    } else if (type=="srow-4p-p") {
-        return new SingleRowFault(fd, false, 4);
-    } else if (type=="srow-np-t") {
-        return new SingleRowFault(fd, true, fd->getChipWidth());
-    } else if (type=="srow-np-p") {
-        return new SingleRowFault(fd, false, fd->getChipWidth());
-    } else if (type=="sbank-1p-t") {
-        return new SingleBankFault(fd, true, 1);
-    } else if (type=="sbank-1p-p") {
-        return new SingleBankFault(fd, false, 1);
-    } else if (type=="sbank-2p-t") {
-        return new SingleBankFault(fd, true, 2);
-    } else if (type=="sbank-2p-p") {
-        return new SingleBankFault(fd, false, 2);
-    } else if (type=="sbank-3p-t") {
-        return new SingleBankFault(fd, true, 3);
-    } else if (type=="sbank-3p-p") {
-        return new SingleBankFault(fd, false, 3);
-    } else if (type=="sbank-4p-t") {
-        return new SingleBankFault(fd, true, 4);
-    } else if (type=="sbank-4p-p") {
-        return new SingleBankFault(fd, false, 4);
-    } else if (type=="sbank-np-t") {
-        return new SingleBankFault(fd, true, fd->getChipWidth());
-    } else if (type=="sbank-np-p") {
-        return new SingleBankFault(fd, false, fd->getChipWidth());
-    } else if (type=="mbank-1p-t") {
-        return new MultiBankFault(fd, true, 1);
-    } else if (type=="mbank-1p-p") {
-        return new MultiBankFault(fd, false, 1);
-    } else if (type=="mbank-2p-t") {
-        return new MultiBankFault(fd, true, 2);
-    } else if (type=="mbank-2p-p") {
-        return new MultiBankFault(fd, false, 2);
-    } else if (type=="mbank-3p-t") {
-        return new MultiBankFault(fd, true, 3);
-    } else if (type=="mbank-3p-p") {
-        return new MultiBankFault(fd, false, 3);
-    } else if (type=="mbank-4p-t") {
-        return new MultiBankFault(fd, true, 4);
-    } else if (type=="mbank-4p-p") {
-        return new MultiBankFault(fd, false, 4);
-    } else if (type=="mbank-np-t") {
-        return new MultiBankFault(fd, true, fd->getChipWidth());
-    } else if (type=="mbank-np-p") {
-        return new MultiBankFault(fd, false, fd->getChipWidth());
-    } else if (type=="mrank-1p-t") {
-        return new MultiRankFault(fd, true, 1);
-    } else if (type=="mrank-1p-p") {
-        return new MultiRankFault(fd, false, 1);
-    } else if (type=="mrank-2p-t") {
-        return new MultiRankFault(fd, true, 2);
-    } else if (type=="mrank-2p-p") {
-        return new MultiRankFault(fd, false, 2);
-    } else if (type=="mrank-3p-t") {
-        return new MultiRankFault(fd, true, 3);
-    } else if (type=="mrank-3p-p") {
-        return new MultiRankFault(fd, false, 3);
-    } else if (type=="mrank-4p-t") {
-        return new MultiRankFault(fd, true, 4);
-    } else if (type=="mrank-4p-p") {
-        return new MultiRankFault(fd, false, 4);
-    } else if (type=="mrank-np-t") {
-        return new MultiRankFault(fd, true, fd->getChipWidth());
-    } else if (type=="mrank-np-p") {
-        return new MultiRankFault(fd, false, fd->getChipWidth());
+//------------------------------------------------------------------------------
+// address fields (as laid out by the masks of Config.hh)
+static const ADDR COLUMN_FIELD = SCOL_MASK & ~DEFAULT_MASK;
+static const ADDR ROW_FIELD = SROW_MASK & ~DEFAULT_MASK;
+static const ADDR BANK_FIELD = MBANK_MASK ^ SBANK_MASK;
+static const ADDR RANK_FIELD = MRANK_MASK ^ MBANK_MASK;
+
+// value in field, or the whole field in mask when the value is any
+static void setField(ADDR field, unsigned value, unsigned any, ADDR *addr, ADDR *mask) {
+    if (value==any) {
+        *mask |= field;
     } else {
-        assert(0);
-        return NULL;
+        *addr |= ((ADDR) value << __builtin_ctzll(field)) & field;
+    }
+}
+
+TraceFault::TraceFault(FaultDomain *_fd, const TraceRecord &record)
+: Fault("Trace") {
+    fd = _fd;
+    isInherent = OPERATIONAL;
+    isTransient = (record.flags & TRACE_TRANSIENT) ? TRANSIENT : PERMANENT;
+    addr = 0;
+    mask = DEFAULT_MASK;
+    setField(COLUMN_FIELD, record.column, TRACE_ANY16, &addr, &mask);
+    setField(ROW_FIELD, record.row, TRACE_ANY32, &addr, &mask);
+    setField(BANK_FIELD, record.bank, TRACE_ANY8, &addr, &mask);
+    setField(RANK_FIELD, record.rank, TRACE_ANY8, &addr, &mask);
+    isMultiColumn = (record.column==TRACE_ANY16);
+    isMultiRow = (record.row==TRACE_ANY32);
+    // blocks of 8 columns
+    int columnBits = __builtin_popcountll(mask & COLUMN_FIELD);
+    int otherBits = __builtin_popcountll(mask & ~DEFAULT_MASK & ~COLUMN_FIELD);
+    affectedBlkCount = (1ull<<otherBits) * ((columnBits>3) ? (1ull<<(columnBits-3)) : 1);
+
+    if (record.beat==TRACE_ANY8) {
+        isSingleBeat = MULTI_BEAT;
+        beatStart = 0;
+        beatEnd = fd->getBeatHeight()-1;
+        beatCount = fd->getBeatHeight();
+    } else {
+        assert(record.beat<fd->getBeatHeight());
+        isSingleBeat = SINGLE_BEAT;
+        beatStart = beatEnd = record.beat;
+        beatCount = 1;
+    }
+
+    isChannel = (record.chip==TRACE_ANY8);
+    chipPos = isChannel ? 0 : record.chip;
+    assert(chipPos<fd->getChipCount());
+    if (isChannel || (record.dq==TRACE_ANY8)) {
+        numDQ = fd->getChipWidth();
+        for (int i=0; i<numDQ; i++) {
+            pinPos[i] = chipPos*fd->getChipWidth() + i;
+        }
+    } else {
+        assert(record.dq<fd->getChipWidth());
+        numDQ = 1;
+        pinPos[0] = chipPos*fd->getChipWidth() + record.dq;
+    }
+    cellFaultRate = .0;
+}
+
+//------------------------------------------------------------------------------
+// fault factory: the type ID of a fault type is its index in this table
+// (create constructs in place at mem, or on the heap when mem is NULL;
+//  copy copy-constructs a fault of the type in place at mem)
+struct FaultFactoryEntry {
+    const char *name;
+    size_t size;
+    Fault *(*create)(void *mem, FaultDomain *fd);
+    Fault *(*copy)(void *mem, const Fault *from);
+};
+
+#define FAULT_TYPE(name, T, ...)                                                \
+    {name, sizeof(T), [](void *mem, FaultDomain *fd) -> Fault * {               \
+        return (mem!=NULL) ? new (mem) T(__VA_ARGS__) : new T(__VA_ARGS__); },  \
+     [](void *mem, const Fault *from) -> Fault * {                              \
+        return new (mem) T(*static_cast<const T *>(from)); }}
+
+static const FaultFactoryEntry faultFactory[] = {
+    FAULT_TYPE("b",          SingleBitFault, fd, false),
+    FAULT_TYPE("w",          SingleWordFault, fd, false, fd->getChipWidth()),
+    FAULT_TYPE("p",          SinglePinFault, fd, false),
+    FAULT_TYPE("c",          SingleChipFault, fd, false, fd->getChipWidth()),
+    FAULT_TYPE("r",          ChannelFault, fd, false),
+    FAULT_TYPE("i3",         InherentFault, fd, 1e-3),
+    FAULT_TYPE("i4",         InherentFault, fd, 1e-4),
+    FAULT_TYPE("i5",         InherentFault, fd, 1e-5),
+    FAULT_TYPE("i6",         InherentFault, fd, 1e-6),
+    FAULT_TYPE("i7",         InherentFault, fd, 1e-7),
+    FAULT_TYPE("i8",         InherentFault, fd, 1e-8),
+    FAULT_TYPE("i9",         InherentFault, fd, 1e-9),
+    FAULT_TYPE("i10",        InherentFault, fd, 1e-10),
+    FAULT_TYPE("i3-1",       InherentFault2, fd, 1e-3, 1),
+    FAULT_TYPE("i4-1",       InherentFault2, fd, 1e-4, 1),
+    FAULT_TYPE("i5-1",       InherentFault2, fd, 1e-5, 1),
+    FAULT_TYPE("i6-1",       InherentFault2, fd, 1e-6, 1),
+    FAULT_TYPE("i7-1",       InherentFault2, fd, 1e-7, 1),
+    FAULT_TYPE("i8-1",       InherentFault2, fd, 1e-8, 1),
+    FAULT_TYPE("i9-1",       InherentFault2, fd, 1e-9, 1),
+    FAULT_TYPE("i10-1",      InherentFault2, fd, 1e-10, 1),
+    FAULT_TYPE("i3-2",       InherentFault2, fd, 1e-3, 2),
+    FAULT_TYPE("i4-2",       InherentFault2, fd, 1e-4, 2),
+    FAULT_TYPE("i5-2",       InherentFault2, fd, 1e-5, 2),
+    FAULT_TYPE("i6-2",       InherentFault2, fd, 1e-6, 2),
+    FAULT_TYPE("i7-2",       InherentFault2, fd, 1e-7, 2),
+    FAULT_TYPE("i8-2",       InherentFault2, fd, 1e-8, 2),
+    FAULT_TYPE("i9-2",       InherentFault2, fd, 1e-9, 2),
+    FAULT_TYPE("i10-2",      InherentFault2, fd, 1e-10, 2),
+    FAULT_TYPE("sbit-t",     SingleBitFault, fd, true),
+    FAULT_TYPE("sbit-p",     SingleBitFault, fd, false),
+    FAULT_TYPE("sword-2p-t", SingleWordFault, fd, true, 2),
+    FAULT_TYPE("sword-2p-p", SingleWordFault, fd, false, 2),
+    FAULT_TYPE("sword-3p-t", SingleWordFault, fd, true, 3),
+    FAULT_TYPE("sword-3p-p", SingleWordFault, fd, false, 3),
+    FAULT_TYPE("sword-4p-t", SingleWordFault, fd, true, 4),
+    FAULT_TYPE("sword-4p-p", SingleWordFault, fd, false, 4),
+    FAULT_TYPE("sword-np-t", SingleWordFault, fd, true, fd->getChipWidth()),
+    FAULT_TYPE("sword-np-p", SingleWordFault, fd, false, fd->getChipWidth()),
+    FAULT_TYPE("scol-1p-t",  SingleColumnFault, fd, true, 1),
+    FAULT_TYPE("scol-1p-p",  SingleColumnFault, fd, false, 1),
+    FAULT_TYPE("scol-2p-t",  SingleColumnFault, fd, true, 2),
+    FAULT_TYPE("scol-2p-p",  SingleColumnFault, fd, false, 2),
+    FAULT_TYPE("scol-3p-t",  SingleColumnFault, fd, true, 3),
+    FAULT_TYPE("scol-3p-p",  SingleColumnFault, fd, false, 3),
+    FAULT_TYPE("scol-4p-t",  SingleColumnFault, fd, true, 4),
+    FAULT_TYPE("scol-4p-p",  SingleColumnFault, fd, false, 4),
+    FAULT_TYPE("scol-np-t",  SingleColumnFault, fd, true, fd->getChipWidth()),
+    FAULT_TYPE("scol-np-p",  SingleColumnFault, fd, false, fd->getChipWidth()),
+    FAULT_TYPE("srow-1p-t",  SingleRowFault, fd, true, 1),
+    FAULT_TYPE("srow-1p-p",  SingleRowFault, fd, false, 1),
+    FAULT_TYPE("srow-2p-t",  SingleRowFault, fd, true, 2),
+    FAULT_TYPE("srow-2p-p",  SingleRowFault, fd, false, 2),
+    FAULT_TYPE("srow-3p-t",  SingleRowFault, fd, true, 3),
+    FAULT_TYPE("srow-3p-p",  SingleRowFault, fd, false, 3),
+    FAULT_TYPE("srow-4p-t",  SingleRowFault, fd, true, 4),
+    FAULT_TYPE("srow-4p-p",  SingleRowFault, fd, false, 4),
+    FAULT_TYPE("srow-np-t",  SingleRowFault, fd, true, fd->getChipWidth()),
+    FAULT_TYPE("srow-np-p",  SingleRowFault, fd, false, fd->getChipWidth()),
+    FAULT_TYPE("sbank-1p-t", SingleBankFault, fd, true, 1),
+    FAULT_TYPE("sbank-1p-p", SingleBankFault, fd, false, 1),
+    FAULT_TYPE("sbank-2p-t", SingleBankFault, fd, true, 2),
+    FAULT_TYPE("sbank-2p-p", SingleBankFault, fd, false, 2),
+    FAULT_TYPE("sbank-3p-t", SingleBankFault, fd, true, 3),
+    FAULT_TYPE("sbank-3p-p", SingleBankFault, fd, false, 3),
+    FAULT_TYPE("sbank-4p-t", SingleBankFault, fd, true, 4),
+    FAULT_TYPE("sbank-4p-p", SingleBankFault, fd, false, 4),
+    FAULT_TYPE("sbank-np-t", SingleBankFault, fd, true, fd->getChipWidth()),
+    FAULT_TYPE("sbank-np-p", SingleBankFault, fd, false, fd->getChipWidth()),
+    FAULT_TYPE("mbank-1p-t", MultiBankFault, fd, true, 1),
+    FAULT_TYPE("mbank-1p-p", MultiBankFault, fd, false, 1),
+    FAULT_TYPE("mbank-2p-t", MultiBankFault, fd, true, 2),
+    FAULT_TYPE("mbank-2p-p", MultiBankFault, fd, false, 2),
+    FAULT_TYPE("mbank-3p-t", MultiBankFault, fd, true, 3),
+    FAULT_TYPE("mbank-3p-p", MultiBankFault, fd, false, 3),
+    FAULT_TYPE("mbank-4p-t", MultiBankFault, fd, true, 4),
+    FAULT_TYPE("mbank-4p-p", MultiBankFault, fd, false, 4),
+    FAULT_TYPE("mbank-np-t", MultiBankFault, fd, true, fd->getChipWidth()),
+    FAULT_TYPE("mbank-np-p", MultiBankFault, fd, false, fd->getChipWidth()),
+    FAULT_TYPE("mrank-1p-t", MultiRankFault, fd, true, 1),
+    FAULT_TYPE("mrank-1p-p", MultiRankFault, fd, false, 1),
+    FAULT_TYPE("mrank-2p-t", MultiRankFault, fd, true, 2),
+    FAULT_TYPE("mrank-2p-p", MultiRankFault, fd, false, 2),
+    FAULT_TYPE("mrank-3p-t", MultiRankFault, fd, true, 3),
+    FAULT_TYPE("mrank-3p-p", MultiRankFault, fd, false, 3),
+    FAULT_TYPE("mrank-4p-t", MultiRankFault, fd, true, 4),
+    FAULT_TYPE("mrank-4p-p", MultiRankFault, fd, false, 4),
+    FAULT_TYPE("mrank-np-t", MultiRankFault, fd, true, fd->getChipWidth()),
+    FAULT_TYPE("mrank-np-p", MultiRankFault, fd, false, fd->getChipWidth()),
+};
+static const int faultFactorySize = sizeof(faultFactory)/sizeof(faultFactory[0]);
+
+int Fault::getFaultTypeID(const std::string &type) {
+    for (int i=0; i<faultFactorySize; i++) {
+        if (type==faultFactory[i].name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char *Fault::getFaultTypeName(int typeID) {
+    assert((typeID>=0) && (typeID<faultFactorySize));
+    return faultFactory[typeID].name;
+}
+
+size_t Fault::getMaxFaultSize() {
+    size_t maxSize = sizeof(TraceFault);
+    for (int i=0; i<faultFactorySize; i++) {
+        maxSize = std::max(maxSize, faultFactory[i].size);
+    }
+    return maxSize;
+}
+
+Fault *Fault::genRandomFault(int typeID, FaultDomain *fd, void *mem) {
+    assert((typeID>=0) && (typeID<faultFactorySize));
+    Fault *fault = faultFactory[typeID].create(mem, fd);
+    fault->typeID = typeID;
+    return fault;
+}
+
+Fault *Fault::genRandomFault(std::string type, FaultDomain *fd) {
+    return genRandomFault(getFaultTypeID(type), fd);
+}
+
+//------------------------------------------------------------------------------
+// what the constructors randomize: the address, the first beat, the chip and
+// pins, and the affected blocks (the rest follows from the type)
+void Fault::saveParams(FaultLogRecord *record) {
+    assert(typeID>=0);
+    assert(affectedBlkCount<=0xFFFFFFFFull);
+    record->addr = addr;
+    record->affectedBlkCount = affectedBlkCount;
+    memset(record->pins, 0, sizeof(record->pins));
+    for (int i=0; i<numDQ; i++) {
+        assert(pinPos[i]<256);
+        record->pins[i] = pinPos[i];
+    }
+    record->typeID = typeID;
+    record->chip = chipPos;
+    record->beat = beatStart;
+}
+
+Fault *Fault::genLoggedFault(const Fault *prototype, FaultDomain *fd, const FaultLogRecord &record, void *mem) {
+    assert(prototype->typeID==record.typeID);
+    Fault *fault = faultFactory[record.typeID].copy(mem, prototype);
+    fault->fd = fd;
+    fault->addr = record.addr;
+    fault->affectedBlkCount = record.affectedBlkCount;
+    for (int i=0; i<fault->numDQ; i++) {
+        fault->pinPos[i] = record.pins[i];
     }
+    fault->chipPos = record.chip;
+    fault->beatStart = record.beat;
+    fault->beatEnd = record.beat+fault->beatCount-1;
+    return fault;
 }
 
 //----------------------------------------------------------
@@ -9,20 +9,38 @@
 
 #include <string>
 #include <random>
+#include <math.h>
 #include "common.hh"
 #include "Config.hh"
 #include "message.hh"
 #include "FaultDomain.hh"
+#include "Random.hh"
+#include "Trace.hh"
+#include "FaultLog.hh"
 #include "limits.h"
 
-//------------------------------------------------------------------------------
-extern std::default_random_engine randomGenerator;
-
 //------------------------------------------------------------------------------
 class Fault {
 public:
-    Fault(std::string _name);
-    Fault(FaultDomain *_fd, std::string _name, ADDR _mask, bool _isInherent, bool _isTransient, int _numDQ, bool _isSingleBeat, bool _isMultiRow, bool _isMultiColumn, bool _isChannel, unsigned long long _affectedBlkCount);
+    Fault(const char *_name);
+    Fault(FaultDomain *_fd, const char *_name, ADDR _mask, bool _isInherent, bool _isTransient, int _numDQ, bool _isSingleBeat, bool _isMultiRow, bool _isMultiColumn, bool _isChannel, unsigned long long _affectedBlkCount);
+    virtual ~Fault() {}
+
+    // move the fault to chipID, keeping its pins within the chip
+    void moveToChip(int chipID, int chipWidth) {
+        for (int i=0; i<numDQ; i++) {
+            pinPos[i] += (chipID-chipPos)*chipWidth;
+        }
+        chipPos = chipID;
+    }
+    // move the fault onto the (first numDQ) pins of other
+    void moveToPins(const Fault *other) {
+        assert(numDQ<=other->numDQ);
+        chipPos = other->chipPos;
+        for (int i=0; i<numDQ; i++) {
+            pinPos[i] = other->pinPos[i];
+        }
+    }
 
 public:
     ADDR getAddr() { return addr; }
@@ -41,7 +59,7 @@ public:
     int  getPinID1() { return pinPos[1]; }
     double getCellFaultRate() { return cellFaultRate; }
 
-    void print(FILE *fd = stdout) { fprintf(fd, "%s ADDR=%016llx MASK=%016llx (T=%d)\n", name.c_str(), addr, getMask(), isTransient); }
+    void print(FILE *fd = stdout) { fprintf(fd, "%s ADDR=%016llx MASK=%016llx (T=%d)\n", name, addr, getMask(), isTransient); }
     bool overlap(Fault *other) {
 		if(other==NULL) return true;
         // Based on "FaultSim: A Fast, Configurable Memory-Reliability Simulator for Conventional and 3D-Stacked Systems"
@@ -53,40 +71,86 @@ public:
         }
         return false;
     }
+    // a uniformly random non-zero error pattern over the pins and beats of the
+    // fault, drawn 64 bits at a time and XORed into the line a beat at a time
     virtual void genRandomError(CacheLine *line) {
+        unsigned long long pinMask = (1ULL<<numDQ)-1;   // numDQ <= 8
         if (beatCount*numDQ>64) {
-            std::uniform_int_distribution<unsigned long long> randDist = std::uniform_int_distribution<unsigned long long>(0, (1ULL<<numDQ)-1);
+            int beatsPerWord = 64/numDQ;
             bool noError = true;
             while (noError) {
+                unsigned long long randValue = 0;
                 for (int beat = 0; beat < beatCount; beat++) {
-                    unsigned long long randValue = randDist(randomGenerator);
-                    for (int pin = 0; pin<numDQ; pin++) {
-                        if ((randValue>>pin)&1) {
-                            line->invBit(line->getChannelWidth()*(beat+beatStart)+pinPos[pin]);
-                            noError = false;
-                        }
+                    if (beat%beatsPerWord==0) {
+                        randValue = randomGenerator.next64();
+                    }
+                    unsigned long long bits = randValue & pinMask;
+                    randValue >>= numDQ;
+                    if (bits!=0) {
+                        invBeat(line, beat, bits);
+                        noError = false;
                     }
                 }
             }
         } else {
             // exclude 0
-            std::uniform_int_distribution<unsigned long long> randDist = std::uniform_int_distribution<unsigned long long>(1, (1ULL<<(beatCount*numDQ))-1);
-            unsigned long long randValue = randDist(randomGenerator);
-            for (int beat = 0; beat < beatCount; beat++) {
-                for (int pin = 0; pin<numDQ; pin++) {
-                    if ((randValue>>(beat*numDQ+pin))&1) {
-                        line->invBit(line->getChannelWidth()*(beat+beatStart)+pinPos[pin]);
-                    }
+            int patternBits = beatCount*numDQ;
+            unsigned long long patternMask = (patternBits==64) ? ~0ULL : (1ULL<<patternBits)-1;
+            unsigned long long randValue;
+            do {
+                randValue = randomGenerator.next64() & patternMask;
+            } while (randValue==0);
+            for (int beat = 0; beat < beatCount; beat++, randValue >>= numDQ) {
+                if ((randValue & pinMask)!=0) {
+                    invBeat(line, beat, randValue & pinMask);
                 }
             }
         }
     }
 
     // static
+    // fault factory indexed by type ID (-1: unknown type name)
+    // - mem: construct in place (getMaxFaultSize() bytes) instead of new
+    static int getFaultTypeID(const std::string &type);
+    static const char *getFaultTypeName(int typeID);
+    static size_t getMaxFaultSize();
+    static Fault *genRandomFault(int typeID, FaultDomain *fd, void *mem = NULL);
     static Fault *genRandomFault(std::string type, FaultDomain *fd);
+    // the randomized parameters of a fault (a fault log arrival), and a copy
+    // of a fault of the same type (prototype) with the logged parameters
+    void saveParams(FaultLogRecord *record);
+    static Fault *genLoggedFault(const Fault *prototype, FaultDomain *fd, const FaultLogRecord &record, void *mem);
+protected:
+    // a uniformly random non-zero error over every bit of the line: a 64-bit
+    // draw covers 64 bits (from the top), unpacked without branches
+    static void genRandomLineError(CacheLine *line) {
+        bool noError = true;
+        while (noError) {
+            for (int top=line->getBitN()-1; top>=0; top-=64) {
+                unsigned long long randValue = randomGenerator.next64();
+                int count = (top<63) ? top+1 : 64;
+                if (count<64) {
+                    randValue &= (1ULL<<count)-1;
+                }
+                noError = noError && (randValue==0);
+                bool *bits = line->bitArr+top;
+                for (int offset=0; offset<count; offset++) {
+                    bits[-offset] ^= (randValue>>offset)&1;
+                }
+            }
+        }
+    }
+    // XOR the pin pattern bits (bit i: pinPos[i]) into a beat of the line
+    void invBeat(CacheLine *line, int beat, unsigned long long bits) {
+        bool *row = line->bitArr + line->getChannelWidth()*(beat+beatStart);
+        for (; bits!=0; bits &= bits-1) {
+            row[pinPos[__builtin_ctzll(bits)]] ^= true;
+        }
+    }
 public:
     FaultDomain *fd;
-    std::string name;
+    const char *name;       // static string (interned per fault class)
+    int typeID;             // factory type ID (-1: not from the factory)
     ADDR addr;
     ADDR mask;
     bool isInherent;
@@ -145,25 +209,7 @@ class ChannelFault: public Fault {
 public:
     ChannelFault(FaultDomain *fd, bool _isTransient)
     : Fault(fd, "Channel", CHANNEL_MASK, OPERATIONAL, _isTransient, fd->getChipWidth(), MULTI_BEAT, MULTI_COLUMN, MULTI_ROW, CHANNEL, ((MRANK_MASK^DEFAULT_MASK)+1)/8) {}
-    void genRandomError(CacheLine *line) {
-        bool noError = true;
-        while (noError) {
-            std::uniform_int_distribution<unsigned long long> randDist = std::uniform_int_distribution<unsigned long long>(0, ULLONG_MAX);
-            unsigned long long randValue = randDist(randomGenerator);
-            int offset = 0;
-            for (int i=line->getBitN()-1; i>=0; i--) {
-                if ((randValue>>offset)&1) {
-                    line->invBit(i);
-                    noError = false;
-                }
-                offset++;
-                if (offset==64) {
-                    randValue = randDist(randomGenerator);
-                    offset = 0;
-                }
-            }
-        }
-    }
+    void genRandomError(CacheLine *line) { genRandomLineError(line); }
 };
 
 //------------------------------------------------------------------------------
@@ -171,7 +217,7 @@ class SingleColumnFault : public Fault {
 public:
     SingleColumnFault(FaultDomain *fd, bool _isTransient, int _numDQ)
     : Fault(fd, "S-col", SCOL_MASK, OPERATIONAL, _isTransient, _numDQ, SINGLE_BEAT, MULTI_ROW, SINGLE_COLUMN, NO_CHANNEL, 0) {
-        double p = ((double)rand())/RAND_MAX;
+        double p = randomGenerator.uniformReal();
         if (p<0.836) {
             // 1 tile (512 rows)
             affectedBlkCount = 512;
@@ -201,17 +247,17 @@ class SingleBankFault : public Fault {
 public:
     SingleBankFault(FaultDomain *fd, bool _isTransient, int _numDQ)
     : Fault(fd, "S-bank", SBANK_MASK, OPERATIONAL, _isTransient, _numDQ, MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL, 0) {
-        double p = ((double)rand())/RAND_MAX;
+        double p = randomGenerator.uniformReal();
         if (p<0.50) {
             // row cluster (entire row)
-            int rowCount = (rand()%84)+2;   // 2~85
+            int rowCount = randomGenerator.uniformInt(84)+2;   // 2~85
             affectedBlkCount = rowCount * (((SROW_MASK^DEFAULT_MASK)>>15)+1)/8;
         } else if (p<0.642) {
             // scattered
-            int rowCount = (rand()%249) + 86;   // 86~334
+            int rowCount = randomGenerator.uniformInt(249) + 86;   // 86~334
             affectedBlkCount = rowCount;
         } else {
-            int rowCount = (rand()%3476) + 335;   // 335~3810
+            int rowCount = randomGenerator.uniformInt(3476) + 335;   // 335~3810
             affectedBlkCount = rowCount;
         }
     }
@@ -221,7 +267,7 @@ class MultiBankFault : public Fault {
 public:
     MultiBankFault(FaultDomain *fd, bool _isTransient, int _numDQ)
     : Fault(fd, "M-bank", MBANK_MASK, OPERATIONAL, _isTransient, _numDQ, MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL, 0) {
-        double p = ((double)rand())/RAND_MAX;
+        double p = randomGenerator.uniformReal();
         int bankCount;
         if (p<0.462) {
             bankCount = 2;
@@ -238,17 +284,17 @@ public:
         }
         if (bankCount<=4) {
             for (int i=0; i<bankCount; i++) {
-                p = ((double)rand())/RAND_MAX;
+                p = randomGenerator.uniformReal();
                 if (p<0.50) {
                     // row cluster (entire row)
-                    int rowCount = (rand()%84)+2;   // 2~85
+                    int rowCount = randomGenerator.uniformInt(84)+2;   // 2~85
                     affectedBlkCount = rowCount * (((SROW_MASK^DEFAULT_MASK)>>15)+1)/8;
                 } else if (p<0.642) {
                     // scattered
-                    int rowCount = (rand()%249) + 86;   // 86~334
+                    int rowCount = randomGenerator.uniformInt(249) + 86;   // 86~334
                     affectedBlkCount = rowCount;
                 } else {
-                    int rowCount = (rand()%3476) + 335;   // 335~3810
+                    int rowCount = randomGenerator.uniformInt(3476) + 335;   // 335~3810
                     affectedBlkCount = rowCount;
                 }
             }
@@ -262,7 +308,7 @@ class MultiRankFault : public Fault {
 public:
     MultiRankFault(FaultDomain *fd, bool _isTransient, int _numDQ)
     : Fault(fd, "M-rank", MRANK_MASK, OPERATIONAL, _isTransient, _numDQ, MULTI_BEAT, MULTI_ROW, MULTI_COLUMN, NO_CHANNEL, 0) {
-        double p = ((double)rand())/RAND_MAX;
+        double p = randomGenerator.uniformReal();
         int bankCount;
         if (p<0.545) {
             bankCount = 8;
@@ -283,55 +329,95 @@ public:
     }
 };
 
+// a fault logged in the field: the footprint of a trace record
+// (TRACE_ANY fields: every row/column/bank/rank, pin of the chip or chip)
+class TraceFault : public Fault {
+public:
+    TraceFault(FaultDomain *fd, const TraceRecord &record);
+
+    void genRandomError(CacheLine *line) {
+        if (isChannel) {
+            genRandomLineError(line);
+        } else {
+            Fault::genRandomError(line);
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+// every cell of a line is faulty with probability cellFaultRate: the faulty
+// cells are walked once with geometric gaps (no collisions, no retries) and
+// flipped, on top of any error already in the line
 class InherentFault: public Fault {
 public:
     InherentFault(FaultDomain *fd, double _cellFaultRate)
-    : Fault("Inherent") { cellFaultRate = _cellFaultRate; }
+    : Fault("Inherent") { setCellFaultRate(_cellFaultRate); }
 
     void genRandomError(CacheLine *line) {
-        std::binomial_distribution<int> distribution(line->getBitN(), cellFaultRate);
-        int faultyCellCount = distribution(randomGenerator);
-        assert(line->isZero());
-        for (int i=0; i<faultyCellCount; i++) {
-            int bitPos = rand()%line->getBitN();
-            if (line->bitArr[bitPos]==0) {
-                line->bitArr[bitPos]=1;
-            } else {
-                // conflict with the previous fault
-                // do it again
-                i--;
+        for (int pos=nextFaultyCell(line, -1); pos<line->getBitN(); pos=nextFaultyCell(line, pos)) {
+            line->invBit(pos);
+        }
+    }
+protected:
+    InherentFault(const char *_name, double _cellFaultRate)
+    : Fault(_name) { setCellFaultRate(_cellFaultRate); }
+
+    void setCellFaultRate(double rate) {
+        cellFaultRate = rate;
+        logGoodCell = log1p(-rate);
+        cleanBitN = -1;
+    }
+    // the first faulty cell after pos (bitN: none)
+    // - the gap is geometric: floor(log(u)/log(1-rate)) with u in (0, 1]
+    // - a whole line is clean with probability (1-rate)^bitN, kept per line
+    //   size, which settles the common case without a log
+    int nextFaultyCell(CacheLine *line, int pos) {
+        int bitN = line->getBitN();
+        double u = 1.0 - randomGenerator.uniformReal();
+        if (pos<0) {
+            if (bitN!=cleanBitN) {
+                cleanBitN = bitN;
+                cleanProb = exp(bitN*logGoodCell);
+            }
+            if (u <= cleanProb) {
+                return bitN;
             }
         }
+        double gap = floor(log(u) / logGoodCell);
+        return (gap < (double) (bitN-pos-1)) ? pos+1+(int) gap : bitN;
     }
+protected:
+    double logGoodCell;     // log(1-cellFaultRate)
+    int cleanBitN;
+    double cleanProb;       // (1-cellFaultRate)^cleanBitN
 };
 
-class InherentFault2: public Fault {
+// at most maxFault of the faulty cells, chosen uniformly (reservoir sampling
+// over the walk)
+class InherentFault2: public InherentFault {
 public:
     InherentFault2(FaultDomain *fd, double _cellFaultRate, int _maxFault)
-    : Fault("Inherent2") { cellFaultRate = _cellFaultRate; maxFault = _maxFault; }
+    : InherentFault("Inherent2", _cellFaultRate) { maxFault = _maxFault; assert(maxFault<=MAX_FAULT); }
 
     void genRandomError(CacheLine *line) {
-        std::binomial_distribution<int> distribution(line->getBitN(), cellFaultRate);
-        int faultyCellCount = distribution(randomGenerator);
-        assert(line->isZero());
-        int limit;
-        if (faultyCellCount > maxFault) {
-            limit = maxFault;
-        } else {
-            limit = faultyCellCount;
-        }
-        for (int i=0; i<limit; i++) {
-            int bitPos = rand()%line->getBitN();
-            if (line->bitArr[bitPos]==0) {
-                line->bitArr[bitPos]=1;
+        int chosen[MAX_FAULT];
+        int count = 0;
+        for (int pos=nextFaultyCell(line, -1); pos<line->getBitN(); pos=nextFaultyCell(line, pos), count++) {
+            if (count<maxFault) {
+                chosen[count] = pos;
             } else {
-                // conflict with the previous fault
-                // do it again
-                i--;
+                int slot = randomGenerator.uniformInt(count+1);
+                if (slot<maxFault) {
+                    chosen[slot] = pos;
+                }
             }
         }
+        for (int i=0; (i<count) && (i<maxFault); i++) {
+            line->invBit(chosen[i]);
+        }
     }
 protected:
+    static const int MAX_FAULT = 8;
     int maxFault;
 };
 
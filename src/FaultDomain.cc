@@ -2,6 +2,11 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <math.h>
+#include <algorithm>
+#include <new>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 #include "Config.hh"
 #include "FaultDomain.hh"
@@ -13,179 +18,319 @@ ErrorType worseErrorType(ErrorType a, ErrorType b) {
 }
 
 //------------------------------------------------------------------------------
-ErrorType FaultDomain::genScenarioRandomFaultAndTest(ECC *ecc, int faultCount, std::string *faults) {
-    CacheLine blk = {pinsPerDevice, (devicesPerRank -(int) retiredChipIDList.size()) * pinsPerDevice - (int) retiredPinIDList.size(), blkHeight};
+ScenarioPlan::ScenarioPlan(int _faultCount, std::string *faults)
+: faultCount(_faultCount) {
+    for (int i=0; i<faultCount; i++) {
+        size_t pos = faults[i].find_first_of("@#");
+        typeIDs.push_back(Fault::getFaultTypeID(faults[i].substr(0, pos)));
+        assert(typeIDs.back()>=0);
+        sameChipAs.push_back((pos==std::string::npos) ? -1 : atoi(faults[i].c_str()+pos+1));
+        samePins.push_back((pos!=std::string::npos) && (faults[i][pos]=='#'));
+        assert((sameChipAs.back()>=-1) && (sameChipAs.back()<i));
+    }
+}
 
-	clear();
+//------------------------------------------------------------------------------
+void FaultTable::push(Fault *fault) {
+    addr.push_back(fault->getAddr());
+    mask.push_back(fault->getMask());
+    chip.push_back(fault->getChipID());
+    pin.push_back(fault->getPinID());
+    numDQ.push_back(fault->getNumDQ());
+}
 
-    int fault1ChipID = -1;
-    int fault2ChipID = -1;
-    int fault3ChipID = -1;
+void FaultTable::erase(size_t i) {
+    addr.erase(addr.begin()+i);
+    mask.erase(mask.begin()+i);
+    chip.erase(chip.begin()+i);
+    pin.erase(pin.begin()+i);
+    numDQ.erase(numDQ.begin()+i);
+}
 
-    // generate fault1
-    if (faultCount > 0) {
-        Fault *fault1 = Fault::genRandomFault(faults[0], this);
-		//GONG
-		operationalFaultList.push_back(fault1);
-        
-		fault1->genRandomError(&blk);
-        fault1ChipID = fault1->getChipID();
-//        delete fault1;
-    }
-    // generate fault2
-    if (faultCount > 1) {
-        Fault *fault2 = NULL;
-        do {
-            if (fault2!=NULL) delete fault2;  // delete previous one
-            fault2 = Fault::genRandomFault(faults[1], this);
-        } while (fault2->getChipID()==fault1ChipID);
-		//GONG
-		operationalFaultList.push_back(fault2);
-        
-		fault2->genRandomError(&blk);
-        fault2ChipID = fault2->getChipID();
-//        delete fault2;
-    }
-
-    // generate fault3
-    if (faultCount > 2) {
-        Fault *fault3 = NULL;
-        do {
-            if (fault3!=NULL) delete fault3;  // delete previous one
-            fault3 = Fault::genRandomFault(faults[2], this);
-        } while ((fault3->getChipID()==fault1ChipID)||(fault3->getChipID()==fault2ChipID));
-		//GONG
-		operationalFaultList.push_back(fault3);
-        
-		fault3->genRandomError(&blk);
-        fault3ChipID = fault3->getChipID();
-//        delete fault3;
-    }
-
-    // generate fault4
-    if (faultCount > 3) {
-        Fault *fault4 = NULL;
-        do {
-            if (fault4!=NULL) delete fault4;  // delete previous one
-            fault4 = Fault::genRandomFault(faults[3], this);
-        } while ((fault4->getChipID()==fault1ChipID)||(fault4->getChipID()==fault2ChipID)||(fault4->getChipID()==fault3ChipID));
-		//GONG
-		operationalFaultList.push_back(fault4);
-        
-		fault4->genRandomError(&blk);
-//        delete fault4;
+void FaultTable::clear() {
+    addr.clear();
+    mask.clear();
+    chip.clear();
+    pin.clear();
+    numDQ.clear();
+}
+
+// two faults overlap when their addresses agree on every bit that neither
+// of them masks (same as Fault::overlap)
+void FaultTable::findOverlaps(ADDR _addr, ADDR _mask, size_t count, std::vector<uint64_t> &bits) const {
+    bits.assign((count+63)/64, 0);
+    size_t i = 0;
+#if defined(__AVX512F__)
+    __m512i addrV = _mm512_set1_epi64(_addr);
+    __m512i maskV = _mm512_set1_epi64(_mask);
+    for (; i+8<=count; i+=8) {
+        __m512i diff = _mm512_xor_si512(_mm512_loadu_si512(&addr[i]), addrV);
+        __m512i care = _mm512_or_si512(_mm512_loadu_si512(&mask[i]), maskV);
+        __mmask8 hit = _mm512_testn_epi64_mask(diff, _mm512_xor_si512(care, _mm512_set1_epi64(-1)));
+        bits[i/64] |= (uint64_t) hit << (i%64);
+    }
+#elif defined(__AVX2__)
+    __m256i addrV = _mm256_set1_epi64x(_addr);
+    __m256i maskV = _mm256_set1_epi64x(_mask);
+    __m256i zero = _mm256_setzero_si256();
+    for (; i+4<=count; i+=4) {
+        __m256i diff = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) &addr[i]), addrV);
+        __m256i care = _mm256_or_si256(_mm256_loadu_si256((const __m256i *) &mask[i]), maskV);
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_andnot_si256(care, diff), zero);
+        uint64_t hit = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+        bits[i/64] |= hit << (i%64);
+    }
+#endif
+    for (; i<count; i++) {
+        uint64_t hit = (((addr[i]^_addr) & ~(mask[i]|_mask))==0);
+        bits[i/64] |= hit << (i%64);
     }
-    assert(faultCount<=4);
+}
 
-    // decode and report the result
-    ErrorType result = ecc->decode(this, blk);
+//------------------------------------------------------------------------------
+unsigned long long RetiredSet::getAddrCount(ADDR _mask) {
+    return 1ull << __builtin_popcountll(_mask & ~DEFAULT_MASK);
+}
+
+// each cube of the set cuts the pieces it overlaps along the bits the piece
+// leaves open and the cube fixes: the halves outside the cube are kept
+void RetiredSet::subtract(ADDR _addr, ADDR _mask) {
+    pieceAddr.assign(1, _addr);
+    pieceMask.assign(1, _mask);
+    for (size_t i=0; (i<addr.size()) && !pieceAddr.empty(); i++) {
+        nextAddr.clear();
+        nextMask.clear();
+        for (size_t j=0; j<pieceAddr.size(); j++) {
+            ADDR a = pieceAddr[j], m = pieceMask[j];
+            if (((a^addr[i]) & ~(m|mask[i]))!=0) {
+                // disjoint
+                nextAddr.push_back(a);
+                nextMask.push_back(m);
+                continue;
+            }
+            for (ADDR split = m & ~mask[i]; split!=0; split &= split-1) {
+                ADDR bit = split & -split;
+                m &= ~bit;
+                nextAddr.push_back((a & ~bit) | (~addr[i] & bit));
+                nextMask.push_back(m);
+                a = (a & ~bit) | (addr[i] & bit);
+            }
+        }
+        pieceAddr.swap(nextAddr);
+        pieceMask.swap(nextMask);
+    }
+}
+
+bool RetiredSet::covers(ADDR _addr, ADDR _mask) {
+    if (addr.empty()) {
+        return false;
+    }
+    subtract(_addr, _mask);
+    return pieceAddr.empty();
+}
+
+unsigned long long RetiredSet::getUncoveredCount(ADDR _addr, ADDR _mask) {
+    if (addr.empty()) {
+        return getAddrCount(_mask);
+    }
+    subtract(_addr, _mask);
+    unsigned long long count = 0;
+    for (size_t j=0; j<pieceAddr.size(); j++) {
+        count += getAddrCount(pieceMask[j]);
+    }
+    return count;
+}
 
+unsigned long long RetiredSet::add(ADDR _addr, ADDR _mask) {
+    subtract(_addr, _mask);
+    unsigned long long added = 0;
+    for (size_t j=0; j<pieceAddr.size(); j++) {
+        addr.push_back(pieceAddr[j]);
+        mask.push_back(pieceMask[j]);
+        added += getAddrCount(pieceMask[j]);
+    }
+    addrCount += added;
+    return added;
+}
+
+//------------------------------------------------------------------------------
+FaultPool::~FaultPool() {
+    for (size_t i=0; i<chunks.size(); i++) {
+        delete[] chunks[i];
+    }
+}
+
+void *FaultPool::alloc() {
+    if (!freeList.empty()) {
+        void *block = freeList.back();
+        freeList.pop_back();
+        return block;
+    }
+    if (blockSize==0) {
+        // round up to keep every block aligned like the first one
+        blockSize = (Fault::getMaxFaultSize()+alignof(long double)-1) / alignof(long double) * alignof(long double);
+    }
+    if (chunkUsed==getChunkBlocks(chunkIndex)) {
+        chunkIndex++;
+        chunkUsed = 0;
+    }
+    if (chunkIndex==chunks.size()) {
+        chunks.push_back(new char[blockSize*getChunkBlocks(chunkIndex)]);
+    }
+    char *block = chunks[chunkIndex] + chunkUsed*blockSize;
+    chunkUsed++;
+    return block;
+}
+
+//------------------------------------------------------------------------------
+ErrorType FaultDomain::genScenarioRandomFaultAndTest(ECC *ecc, int faultCount, std::string *faults) {
+    ErrorType result;
+    genScenarioRandomFaultAndTest(1, &ecc, ScenarioPlan(faultCount, faults), &result);
     return result;
 }
 
-ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc) {
-    CacheLine blk = {pinsPerDevice, (devicesPerRank -(int) retiredChipIDList.size()) * pinsPerDevice - (int) retiredPinIDList.size(), blkHeight};
-    Fault *newFault;
-    ErrorType result = NE;
+void FaultDomain::genScenarioRandomFaultAndTest(int eccCount, ECC **eccs, int faultCount, std::string *faults, ErrorType *results) {
+    genScenarioRandomFaultAndTest(eccCount, eccs, ScenarioPlan(faultCount, faults), results);
+}
 
+// generate the faults and the error pattern once, and decode it with every ECC
+// (common random numbers: each ECC decodes the same pattern, with the same
+//  decode-time random draws from event 1 of the current run)
+void FaultDomain::genScenarioRandomFaultAndTest(int eccCount, ECC **eccs, const ScenarioPlan &plan, ErrorType *results) {
+    CacheLine blk = {pinsPerDevice, (devicesPerRank - retiredChipCount) * pinsPerDevice - retiredPinCount, blkHeight};
+
+	clear();
+
+    // generate the faults and place them on their chips: the distinct chips
+    // are drawn without replacement (partial Fisher-Yates over chipOrder), the
+    // others follow their fault
+    // - chipOrder restarts from the identity, so that the placement depends
+    //   only on the draws of this iteration
+    chipOrder.resize(devicesPerRank);
+    for (int i=0; i<devicesPerRank; i++) {
+        chipOrder[i] = i;
+    }
+    int distinctCount = 0;
+    for (int i=0; i<plan.faultCount; i++) {
+        Fault *fault = genFault(plan.typeIDs[i]);
+        int k = plan.sameChipAs[i];
+        assert((k<0) || !operationalFaultList[k]->getIsInherent());
+        if (fault->getIsInherent()) {
+            // spread over the line
+            assert(k<0);
+        } else if (k<0) {
+            assert(distinctCount<devicesPerRank);
+            int pick = distinctCount + randomGenerator.uniformInt(devicesPerRank-distinctCount);
+            std::swap(chipOrder[distinctCount], chipOrder[pick]);
+            fault->moveToChip(chipOrder[distinctCount++], pinsPerDevice);
+        } else if (plan.samePins[i]) {
+            fault->moveToPins(operationalFaultList[k]);
+        } else {
+            fault->moveToChip(operationalFaultList[k]->getChipID(), pinsPerDevice);
+        }
+		//GONG
+		addFault(fault);
+
+		fault->genRandomError(&blk);
+    }
+
+    // decode and report the result
+    if (eccCount==1) {
+        randomGenerator.startEvent(1);
+        results[0] = eccs[0]->decode(this, blk);
+        return;
+    }
+    CacheLine errorBlk = {blk.getChipWidth(), blk.getChannelWidth(), blk.getBeatHeight()};
+    for (int i=0; i<eccCount; i++) {
+        errorBlk.copy(&blk);
+        randomGenerator.startEvent(1);
+        results[i] = eccs[i]->decode(this, errorBlk);
+    }
+}
+
+ErrorType FaultDomain::genSystemRandomFaultAndTest(ECC *ecc, double hr) {
     //----------------------------------------------------------
     // 1. generate a new fault
     //----------------------------------------------------------
-    std::string newFaultType = faultRateInfo->pickRandomType();
-    newFault = Fault::genRandomFault(newFaultType, this);
+    return testNewFault(ecc, genSystemRandomFault(hr));
+}
+
+Fault *FaultDomain::genSystemRandomFault(double hr) {
+    return genFault(faultRateInfo->pickRandomTypeID(hr));
+}
+
+// a logged fault: rebuilt without any random draw
+ErrorType FaultDomain::genLoggedFaultAndTest(ECC *ecc, const Fault *prototype, const FaultLogRecord &record) {
+    return testNewFault(ecc, Fault::genLoggedFault(prototype, this, record, faultPool.alloc()));
+}
+
+// a fault logged in the field: NE without a decode when the domain holds the
+// same fault already (another report of it)
+ErrorType FaultDomain::genTraceFaultAndTest(ECC *ecc, const TraceRecord &record, bool *isRepeat) {
+    Fault *newFault = new (faultPool.alloc()) TraceFault(this, record);
+    for (size_t i=0; i<faultTable.size(); i++) {
+        if ((faultTable.addr[i]==newFault->getAddr()) && (faultTable.mask[i]==newFault->getMask())
+         && (faultTable.pin[i]==newFault->getPinID()) && (faultTable.numDQ[i]==newFault->getNumDQ())
+         && (operationalFaultList[i]->getIsTransient()==newFault->getIsTransient())) {
+            releaseFault(newFault);
+            *isRepeat = true;
+            return NE;
+        }
+    }
+    *isRepeat = false;
+    return testNewFault(ecc, newFault);
+}
+
+// add a new fault and decode the error patterns it can be part of
+ErrorType FaultDomain::testNewFault(ECC *ecc, Fault *newFault) {
+    CacheLine blk = {pinsPerDevice, (devicesPerRank - retiredChipCount) * pinsPerDevice - retiredPinCount, blkHeight};
+    ErrorType result = NE;
 
     //----------------------------------------------------------
     // check whether the fault is on a retired chip or pin
     //----------------------------------------------------------
     // a new fault on already retired chip -> skip
-    for (auto it = retiredChipIDList.cbegin(); it != retiredChipIDList.cend(); ++it) {
-        if (newFault->getChipID()==(*it)) {
-            delete newFault;
-            return NE;
-        }
-    }
     // a new pin fault on already retired pin -> skip
-    if (newFault->getIsSingleDQ()) {
-        // retired pin
-        for (auto it = retiredPinIDList.cbegin(); it != retiredPinIDList.cend(); ++it) {
-            if (newFault->getPinID()==(*it)) {
-                delete newFault;
-                return NE;
-            }
-        }
+    // a new fault on already retired addresses only -> skip
+    if (isChipRetired(newFault->getChipID())
+     || (newFault->getIsSingleDQ() && isPinRetired(newFault->getPinID()))
+     || retiredSet.covers(newFault->getAddr(), newFault->getMask())) {
+        releaseFault(newFault);
+        return NE;
     }
 
 #if 1
-    operationalFaultList.push_back(newFault);
+    addFault(newFault);
 
     //----------------------------------------------------------
     // 3. check overlapping previous fault
     // - check the most severe one
+    // - only the previous faults overlapping the new one can be part of an
+    //   error pattern with it: index them (newest first) with their pairwise
+    //   overlaps, and decode every clique of them that no older candidate
+    //   extends (any depth)
     //----------------------------------------------------------
-    auto it1 = operationalFaultList.crbegin();
-    bool overlap1 = false;
-    for (++it1; it1!=operationalFaultList.crend(); ++it1) {
-        if ((*it1)->overlap(newFault)) {
-            overlap1 = true;
-            bool overlap2 = false;
-            auto it2 = it1;
-            for (++it2; it2!=operationalFaultList.crend(); ++it2) {
-                if ((*it2)->overlap(newFault) && (*it2)->overlap(*it1)) {
-                    overlap2 = true;
-                    bool overlap3 = false;
-                    auto it3 = it2;
-                    for (++it3; it3!=operationalFaultList.crend(); ++it3) {
-                        if ((*it3)->overlap(newFault) && (*it3)->overlap(*it1) && (*it3)->overlap(*it2)) {
-                            overlap3 = true;
-                            bool overlap4 = false;
-                            auto it4 = it3;
-                            for (++it4; it4!=operationalFaultList.crend(); ++it4) {
-                                if ((*it4)->overlap(newFault) && (*it4)->overlap(*it1) && (*it4)->overlap(*it2) && (*it4)->overlap(*it3)) {
-                                    overlap4 = true;
-                                    assert(0);
-                                }
-                            }
-                            if (!overlap4) {
-                                blk.reset();
-                                if (inherentFault!=NULL) inherentFault->genRandomError(&blk);
-                                (*it1)->genRandomError(&blk);
-                                (*it2)->genRandomError(&blk);
-                                (*it3)->genRandomError(&blk);
-                                newFault->genRandomError(&blk);
-                                result = worseErrorType(result, ecc->decode(this, blk));
-                            }
-                        }
-                    }
-                    if (!overlap3) {
-                        blk.reset();
-                        if (inherentFault!=NULL) inherentFault->genRandomError(&blk);
-                        (*it1)->genRandomError(&blk);
-                        (*it2)->genRandomError(&blk);
-                        newFault->genRandomError(&blk);
-                        result = worseErrorType(result, ecc->decode(this, blk));
-                    }
-                }
-            }
-            if (!overlap2) {
-                blk.reset();
-                if (inherentFault!=NULL) inherentFault->genRandomError(&blk);
-                (*it1)->genRandomError(&blk);
-                newFault->genRandomError(&blk);
-                result = worseErrorType(result, ecc->decode(this, blk));
-            }
+    int prevCount = operationalFaultList.size()-1;
+    faultTable.findOverlaps(newFault->getAddr(), newFault->getMask(), prevCount, overlapBits);
+    overlapCandidates.clear();
+    for (int w=(prevCount+63)/64-1; w>=0; w--) {
+        for (uint64_t bits=overlapBits[w]; bits!=0; bits&=~(1ull<<(63-__builtin_clzll(bits)))) {
+            overlapCandidates.push_back(operationalFaultList[w*64+63-__builtin_clzll(bits)]);
         }
     }
-    if (!overlap1) {
-        blk.reset();
-        if (inherentFault!=NULL) inherentFault->genRandomError(&blk);
-        newFault->genRandomError(&blk);
-        result = worseErrorType(result, ecc->decode(this, blk));
+    int candidateCount = overlapCandidates.size();
+    overlapMatrix.resize(candidateCount*candidateCount);
+    for (int i=0; i<candidateCount; i++) {
+        for (int j=i+1; j<candidateCount; j++) {
+            overlapMatrix[i*candidateCount+j] = overlapMatrix[j*candidateCount+i] = overlapCandidates[i]->overlap(overlapCandidates[j]);
+        }
     }
+    overlapClique.resize(candidateCount);
+    result = worseErrorType(result, decodeOverlapCliques(ecc, newFault, blk, 0, 0));
 
     if ((result==CE)&&ecc->getDoRetire()&&ecc->needRetire(this, newFault)) {
-        retiredBlkCount += newFault->getAffectedBlkCount();
-        operationalFaultList.remove(newFault);
-        delete newFault;
+        retireFault(newFault);
+        removeFault(newFault);
     }
     return result;
 #else
@@ -242,57 +387,146 @@ void FaultDomain::setInitialRetiredBlkCount(ECC *ecc) {
     //}
 }
 
+// only the share of the fault outside the retired addresses adds blocks
+// - a fault spanning its whole footprint (a block per 8 addresses, as the
+//   fault types count it) joins the retired addresses
+// - others (sampled row/bank counts, a chip fault in one rank of the two)
+//   cover an unknown part of it: their share is counted, not placed
+void FaultDomain::retireFault(Fault *fault) {
+    ADDR addr = fault->getAddr(), mask = fault->getMask();
+    unsigned long long footprint = RetiredSet::getAddrCount(mask);
+    unsigned long long footprintBlkCount = (footprint>8) ? footprint/8 : 1;
+    unsigned long long newAddrCount = (fault->getAffectedBlkCount()==footprintBlkCount) ? retiredSet.add(addr, mask)
+                                                                                       : retiredSet.getUncoveredCount(addr, mask);
+    retiredBlkCount += fault->getAffectedBlkCount()*newAddrCount/footprint;
+}
+
 void FaultDomain::scrub() {
-    auto it = operationalFaultList.begin();
-    while (it != operationalFaultList.end()) {
-        if ((*it)->getIsTransient()==true) {
-            delete *it;
-            it = operationalFaultList.erase(it);
-            // continue without advancing the iterator
+    for (size_t i=0; i<operationalFaultList.size(); ) {
+        if (operationalFaultList[i]->getIsTransient()==true) {
+            eraseFault(i);
+            // continue without advancing the index
         } else {
-            ++it;
+            i++;
         }
     }
 }
 
+bool FaultDomain::hasTransientFault() const {
+    for (size_t i=0; i<operationalFaultList.size(); i++) {
+        if (operationalFaultList[i]->getIsTransient()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 //------------------------------------------------------------------------------
 void FaultDomain::retirePin(int pinID) {
-    auto it = operationalFaultList.begin();
-    while (it != operationalFaultList.end()) {
-        if ((*it)->getIsSingleDQ() && ((*it)->getPinID()==pinID)) {
+    for (size_t i=0; i<faultTable.size(); ) {
+        if ((faultTable.numDQ[i]==1) && (faultTable.pin[i]==pinID)) {
             // pin fault
-            delete *it;
-            it = operationalFaultList.erase(it);
-            // continue without advancing the iterator
+            eraseFault(i);
+            // continue without advancing the index
         } else {
-            ++it;
+            i++;
         }
     }
-    retiredPinIDList.push_back(pinID);
+    if (!isPinRetired(pinID)) {
+        retiredPinMask[pinID/64] |= 1ull<<(pinID%64);
+        retiredPinCount++;
+    }
 }
 
 void FaultDomain::retireChip(int chipID) {
-    auto it = operationalFaultList.begin();
-    while (it != operationalFaultList.end()) {
-        if ((*it)->getChipID()==chipID) {
-            delete *it;
-            it = operationalFaultList.erase(it);
-            // continue without advancing the iterator
+    for (size_t i=0; i<faultTable.size(); ) {
+        if (faultTable.chip[i]==chipID) {
+            eraseFault(i);
+            // continue without advancing the index
         } else {
-            ++it;
+            i++;
         }
     }
-    retiredChipIDList.push_back(chipID);
+    if (!isChipRetired(chipID)) {
+        retiredChipMask |= 1ull<<chipID;
+        retiredChipCount++;
+    }
 }
 
+// O(1) in the number of faults: the pool takes all of them back at once
 void FaultDomain::clear() {
-    for (auto it = operationalFaultList.begin(); it != operationalFaultList.end(); ++it) {
-        delete *it;
-    }
     operationalFaultList.clear();
-    retiredChipIDList.clear();
-    retiredPinIDList.clear();
+    faultTable.clear();
+    scrubPending = false;
+    faultPool.reset();
+    retiredChipMask = 0;
+    for (int i=0; i<RETIRED_PIN_WORDS; i++) {
+        retiredPinMask[i] = 0;
+    }
+    retiredChipCount = 0;
+    retiredPinCount = 0;
+    retiredBlkCount = 0;
+    retiredSet.clear();
+}
 
+//------------------------------------------------------------------------------
+// clique: overlapCandidates[overlapClique[0...depth-1]], which all overlap each
+// other and the new fault. Extend it with every later candidate that overlaps
+// all of it, or decode it when there is none.
+ErrorType FaultDomain::decodeOverlapCliques(ECC *ecc, Fault *newFault, CacheLine &blk, int depth, int next) {
+    ErrorType result = NE;
+    int candidateCount = overlapCandidates.size();
+    bool extended = false;
+    for (int i=next; i<candidateCount; i++) {
+        bool overlapAll = true;
+        for (int d=0; (d<depth) && overlapAll; d++) {
+            overlapAll = overlapMatrix[overlapClique[d]*candidateCount+i];
+        }
+        if (overlapAll) {
+            extended = true;
+            overlapClique[depth] = i;
+            result = worseErrorType(result, decodeOverlapCliques(ecc, newFault, blk, depth+1, i+1));
+        }
+    }
+    if (!extended) {
+        blk.reset();
+        if (inherentFault!=NULL) inherentFault->genRandomError(&blk);
+        for (int d=0; d<depth; d++) {
+            overlapCandidates[overlapClique[d]]->genRandomError(&blk);
+        }
+        newFault->genRandomError(&blk);
+        result = worseErrorType(result, ecc->decode(this, blk));
+    }
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// faults of the domain live in faultPool
+Fault *FaultDomain::genFault(int typeID) {
+    return Fault::genRandomFault(typeID, this, faultPool.alloc());
+}
+
+void FaultDomain::releaseFault(Fault *fault) {
+    fault->~Fault();
+    faultPool.release(fault);
+}
+
+void FaultDomain::addFault(Fault *fault) {
+    operationalFaultList.push_back(fault);
+    faultTable.push(fault);
+}
+
+void FaultDomain::eraseFault(size_t i) {
+    releaseFault(operationalFaultList[i]);
+    operationalFaultList.erase(operationalFaultList.begin()+i);
+    faultTable.erase(i);
+}
+
+void FaultDomain::removeFault(Fault *fault) {
+    auto it = std::find(operationalFaultList.begin(), operationalFaultList.end(), fault);
+    if (it!=operationalFaultList.end()) {
+        eraseFault(it-operationalFaultList.begin());
+    }
 }
 
 void FaultDomain::print(FILE *fd) const {
@@ -316,7 +550,7 @@ int FaultDomain::FaultyChipDetect(){
 		chip_set.insert((*operationalFaultList.begin())->getChipID());
 		num_chip_fault=1;
 	}else{
-		for(std::list<Fault*>::reverse_iterator it = operationalFaultList.rbegin(); it != operationalFaultList.rend(); it++){
+		for(std::vector<Fault*>::reverse_iterator it = operationalFaultList.rbegin(); it != operationalFaultList.rend(); it++){
 			//check if it has chip-level fault (bank, rank)
 			//ideally we can figure out faulty chip by accessing/correcting adjacent blocks
 			if( !(*it)->getIsSingleBeat() ){
@@ -2,10 +2,110 @@
 #define __FAULT_DOMAIN_HH__
 
 #include <list>
+#include <vector>
+#include <stdint.h>
+#include <assert.h>
 #include "FaultRateInfo.hh"
 
 class ECC;
 class Fault;
+class CacheLine;
+struct TraceRecord;
+struct FaultLogRecord;
+
+//------------------------------------------------------------------------------
+// fault scenario compiled once: the fault type names are resolved to factory
+// IDs up front, so that an iteration runs without any string handling
+// - type   : on a chip of its own (distinct from the other such faults)
+// - type@k : on the chip of fault k (k < its index)
+// - type#k : on pins of fault k (at most as many pins as fault k)
+// (all faults of a scenario hit the same line, thus the same rank)
+class ScenarioPlan {
+public:
+    ScenarioPlan() : faultCount(0) {}
+    ScenarioPlan(int faultCount, std::string *faults);
+public:
+    int faultCount;
+    std::vector<int> typeIDs;
+    std::vector<int> sameChipAs;    // fault index (-1: a chip of its own)
+    std::vector<char> samePins;     // and on its pins
+};
+
+//------------------------------------------------------------------------------
+// fixed-size block pool for the faults of a FaultDomain
+// - blocks are carved from chunks kept for the lifetime of the pool, and
+//   released blocks are reused first (free list)
+// - reset() takes every block back in O(1): faults hold no resources, so
+//   their storage is reused without running destructors
+class FaultPool {
+public:
+    FaultPool() : blockSize(0), chunkIndex(0), chunkUsed(0) {}
+    ~FaultPool();
+
+    void *alloc();
+    void release(void *block) { freeList.push_back(block); }
+    void reset() { chunkIndex = 0; chunkUsed = 0; freeList.clear(); }
+protected:
+    // chunk i holds 2<<i blocks up to 64, so that the many domains of a
+    // fleet that see a fault or two stay small
+    static size_t getChunkBlocks(size_t i) { return (i<5) ? (2u<<i) : 64; }
+    size_t blockSize;
+    std::vector<char *> chunks;
+    size_t chunkIndex;      // bump position: block chunkUsed of chunk chunkIndex
+    size_t chunkUsed;
+    std::vector<void *> freeList;
+};
+
+//------------------------------------------------------------------------------
+// packed (structure-of-arrays) copy of the fault fields scanned per fault
+// arrival; entry i mirrors FaultDomain::operationalFaultList[i]
+class FaultTable {
+public:
+    void push(Fault *fault);
+    void erase(size_t i);
+    void clear();
+    size_t size() const { return addr.size(); }
+
+    // overlap test of (_addr, _mask) against entries [0, count) at once
+    // - bit i%64 of bits[i/64]: entry i overlaps
+    // - AVX-512 / AVX2 when the target has it, scalar otherwise
+    void findOverlaps(ADDR _addr, ADDR _mask, size_t count, std::vector<uint64_t> &bits) const;
+public:
+    std::vector<ADDR> addr;
+    std::vector<ADDR> mask;
+    std::vector<int> chip;
+    std::vector<int> pin;
+    std::vector<int> numDQ;
+};
+
+//------------------------------------------------------------------------------
+// retired addresses of a domain: a union of address cubes (addr, mask: mask
+// bit 1 = any value, as in Fault) kept as disjoint cubes, so that coverage
+// and size are exact
+// - cubes only come from retirement, which is rare: a handful per domain
+class RetiredSet {
+public:
+    RetiredSet() : addrCount(0) {}
+
+    // every address of (_addr, _mask) is retired
+    bool covers(ADDR _addr, ADDR _mask);
+    // the number of addresses of (_addr, _mask) not retired
+    unsigned long long getUncoveredCount(ADDR _addr, ADDR _mask);
+    // retire (_addr, _mask): the number of addresses newly retired
+    unsigned long long add(ADDR _addr, ADDR _mask);
+    // the number of retired addresses (outside DEFAULT_MASK)
+    unsigned long long getAddrCount() const { return addrCount; }
+    static unsigned long long getAddrCount(ADDR _mask);
+    void clear() { addr.clear(); mask.clear(); addrCount = 0; }
+protected:
+    // (_addr, _mask) minus the set, as disjoint cubes in pieceAddr/pieceMask
+    void subtract(ADDR _addr, ADDR _mask);
+protected:
+    std::vector<ADDR> addr;
+    std::vector<ADDR> mask;
+    unsigned long long addrCount;
+    std::vector<ADDR> pieceAddr, pieceMask, nextAddr, nextMask;    // scratch
+};
 
 //------------------------------------------------------------------------------
 class FaultDomain {
@@ -14,6 +114,8 @@ public:
     : ranksPerDomain(_ranksPerDomain), devicesPerRank(_devicesPerRank),
       pinsPerDevice(_pinsPerDevice), blkHeight(_blkHeight),
       faultRateInfo(_faultRateInfo), inherentFault(NULL) {
+          assert(devicesPerRank<=64);
+          assert(getChannelWidth()<=64*RETIRED_PIN_WORDS);
           clear();
       }
 
@@ -23,26 +125,47 @@ public:
     int getChipCount() { return devicesPerRank; }
     int getBeatHeight() { return blkHeight; }
     double getFaultRate() { return ranksPerDomain*devicesPerRank*faultRateInfo->getTotalRate(); }
+    double getHazard(double hr) { return ranksPerDomain*devicesPerRank*faultRateInfo->getHazard(hr); }
 
     void setInherentFault(Fault *fault) { inherentFault = fault; }
     void setInitialRetiredBlkCount(ECC *ecc);
 
     unsigned long long getRetiredBlkCount() { return retiredBlkCount; }
-    size_t getRetiredChipCount() { return retiredChipIDList.size(); }
-    size_t getRetiredPinCount() { return retiredPinIDList.size(); }
+    int getRetiredChipCount() { return retiredChipCount; }
+    int getRetiredPinCount() { return retiredPinCount; }
+    bool isChipRetired(int chipID) const { return (retiredChipMask>>chipID) & 1; }
+    bool isPinRetired(int pinID) const { return (retiredPinMask[pinID/64]>>(pinID%64)) & 1; }
 
 // For fault generation based on scenario
     ErrorType genScenarioRandomFaultAndTest(ECC *ecc, int faultCount, std::string *faults);
+    void genScenarioRandomFaultAndTest(int eccCount, ECC **eccs, int faultCount, std::string *faults, ErrorType *results);
+    void genScenarioRandomFaultAndTest(int eccCount, ECC **eccs, const ScenarioPlan &plan, ErrorType *results);
 // For fault generation based on fault rates
-    ErrorType genSystemRandomFaultAndTest(ECC *ecc);
+    ErrorType genSystemRandomFaultAndTest(ECC *ecc, double hr);
+    // (in two steps, to log the fault before its decode)
+    Fault *genSystemRandomFault(double hr);
+    ErrorType testNewFault(ECC *ecc, Fault *newFault);
+    void releaseFault(Fault *fault);
+// For fault replay from a fault log (prototype: a fault of the logged type)
+    ErrorType genLoggedFaultAndTest(ECC *ecc, const Fault *prototype, const FaultLogRecord &record);
+// For fault replay from a field trace
+    ErrorType genTraceFaultAndTest(ECC *ecc, const TraceRecord &record, bool *isRepeat);
 
     void retirePin(int pinID);
     void retireChip(int chipID);
 
     void scrub();
+    bool hasTransientFault() const;
 
     void clear();
     void print(FILE *fd = stdout) const;
+protected:
+    ErrorType decodeOverlapCliques(ECC *ecc, Fault *newFault, CacheLine &blk, int depth, int next);
+    void retireFault(Fault *fault);
+    Fault *genFault(int typeID);
+    void addFault(Fault *fault);
+    void eraseFault(size_t i);
+    void removeFault(Fault *fault);
 public:
     int ranksPerDomain;
     int devicesPerRank;
@@ -52,11 +175,32 @@ public:
     FaultRateInfo *faultRateInfo;
 
     Fault *inherentFault;
-    std::list<Fault *> operationalFaultList;
-
+    std::vector<Fault *> operationalFaultList;
+    FaultPool faultPool;
+    FaultTable faultTable;
+    bool scrubPending;      // a scrub of this domain is scheduled (TesterSystem)
+    std::vector<int> chipOrder;     // chip permutation (distinct-chip sampling of scenarios)
+
+    // overlap search of the last new fault (reused across faults)
+    // - overlapBits: faultTable.findOverlaps() of it
+    // - overlapCandidates: previous faults overlapping it, newest first
+    // - overlapMatrix[i*n+j]: whether candidates i and j overlap
+    // - overlapClique: candidate indices of the clique being extended
+    std::vector<uint64_t> overlapBits;
+    std::vector<Fault *> overlapCandidates;
+    std::vector<char> overlapMatrix;
+    std::vector<int> overlapClique;
+
+    // retired blocks: the initial ones of an inherent fault (scattered, no
+    // address) plus the retired faults, without counting any address twice
     unsigned long long retiredBlkCount;
-    std::list<int> retiredPinIDList;
-    std::list<int> retiredChipIDList;
+    RetiredSet retiredSet;
+    // retired chips and pins: bit i of the mask (and their counts)
+    static const int RETIRED_PIN_WORDS = 4;
+    uint64_t retiredChipMask;
+    uint64_t retiredPinMask[RETIRED_PIN_WORDS];
+    int retiredChipCount;
+    int retiredPinCount;
 
 	//GONG
 	int FaultyChipDetect();
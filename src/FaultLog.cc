@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+
+#include "FaultLog.hh"
+
+//------------------------------------------------------------------------------
+bool FaultLogWriter::open(const char *name, const FaultLogHeader &_header) {
+    close();
+    file = fopen(name, "wb");
+    if (file==NULL) {
+        printf("Cannot create %s\n", name);
+        return false;
+    }
+    header = _header;
+    memcpy(header.magic, FAULT_LOG_MAGIC, sizeof(header.magic));
+    header.version = FAULT_LOG_VERSION;
+    header.recordSize = sizeof(FaultLogRecord);
+    header.runCount = 0;
+    header.lifetimeCount = 0;
+    fwrite(&header, sizeof(header), 1, file);
+    return true;
+}
+
+void FaultLogWriter::close() {
+    if (file!=NULL) {
+        fseek(file, 0, SEEK_SET);
+        fwrite(&header, sizeof(header), 1, file);
+        fclose(file);
+    }
+    file = NULL;
+}
+
+void FaultLogWriter::writeLifetime(uint64_t runNum, double logWeight) {
+    FaultLogLifetime lifetime;
+    memset(&lifetime, 0, sizeof(lifetime));
+    lifetime.runNum = runNum;
+    lifetime.logWeight = logWeight;
+    lifetime.faultCount = faults.size();
+    fwrite(&lifetime, sizeof(lifetime), 1, file);
+    fwrite(faults.data(), sizeof(FaultLogRecord), faults.size(), file);
+    header.lifetimeCount++;
+    faults.clear();
+}
+
+//------------------------------------------------------------------------------
+bool FaultLogReader::open(const char *name) {
+    close();
+    int file = ::open(name, O_RDONLY);
+    if (file<0) {
+        printf("Cannot open fault log %s\n", name);
+        return false;
+    }
+    struct stat st;
+    if ((fstat(file, &st)!=0) || ((size_t) st.st_size<sizeof(FaultLogHeader))) {
+        printf("Fault log %s has no header\n", name);
+        ::close(file);
+        return false;
+    }
+    size = st.st_size;
+    base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (base==MAP_FAILED) {
+        printf("Cannot map fault log %s\n", name);
+        base = NULL;
+        return false;
+    }
+
+    // index the lifetimes (in run order, within the file)
+    const FaultLogHeader &header = getHeader();
+    bool ok = (memcmp(header.magic, FAULT_LOG_MAGIC, sizeof(header.magic))==0) && (header.version==FAULT_LOG_VERSION)
+           && (header.recordSize==sizeof(FaultLogRecord));
+    const char *pos = (const char *) base + sizeof(FaultLogHeader);
+    const char *end = (const char *) base + size;
+    while (ok && (pos<end)) {
+        const FaultLogLifetime *lifetime = (const FaultLogLifetime *) pos;
+        ok = (pos+sizeof(FaultLogLifetime)<=end) && (lifetime->runNum<header.runCount)
+          && (lifetimes.empty() || (lifetimes.back()->runNum<lifetime->runNum))
+          && ((size_t) (end-pos-sizeof(FaultLogLifetime))/sizeof(FaultLogRecord) >= lifetime->faultCount);
+        if (ok) {
+            lifetimes.push_back(lifetime);
+            pos = (const char *) (getFaults(lifetime)+lifetime->faultCount);
+        }
+    }
+    if (!ok || (lifetimes.size()!=header.lifetimeCount)) {
+        printf("Fault log %s is malformed (or of another version)\n", name);
+        close();
+        return false;
+    }
+    return true;
+}
+
+void FaultLogReader::close() {
+    if (base!=NULL) {
+        munmap(base, size);
+    }
+    base = NULL;
+    size = 0;
+    lifetimes.clear();
+}
+
+//------------------------------------------------------------------------------
+const FaultLogLifetime *FaultLogReader::findLifetime(uint64_t runNum) const {
+    auto it = std::lower_bound(lifetimes.begin(), lifetimes.end(), runNum,
+        [](const FaultLogLifetime *lifetime, uint64_t run) { return lifetime->runNum<run; });
+    return (it==lifetimes.end()) ? NULL : *it;
+}
+
+const FaultLogLifetime *FaultLogReader::nextLifetime(const FaultLogLifetime *lifetime) const {
+    const char *next = (const char *) (getFaults(lifetime)+lifetime->faultCount);
+    return (next<(const char *) base+size) ? (const FaultLogLifetime *) next : NULL;
+}
@@ -0,0 +1,103 @@
+#ifndef __FAULT_LOG_HH__
+#define __FAULT_LOG_HH__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Binary log of the fault timelines of a system simulation (native byte order)
+// - a FaultLogHeader, then per non-empty lifetime (in run order) a
+//   FaultLogLifetime and its faultCount FaultLogRecords
+// - a timeline runs up to the horizon regardless of the outcome of the ECC
+//   that recorded it, so that any ECC of the same geometry can replay it
+#define FAULT_LOG_MAGIC     "ECCFAULT"
+#define FAULT_LOG_VERSION   1
+
+struct FaultLogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t seed;
+    uint64_t runCount;          // the log covers runs [0, runCount)
+    uint64_t lifetimeCount;     // non-empty lifetimes logged
+    double rateScale;           // importance sampling of the recording
+    double typeBias;
+    double emptyLogWeight;      // log weight of a lifetime without a fault
+    // geometry of a domain (and of the group)
+    uint32_t domainCount;
+    uint16_t ranksPerDomain;
+    uint16_t chipCount;
+    uint16_t chipWidth;
+    uint16_t beatHeight;
+    uint32_t reserved;
+};
+
+struct FaultLogLifetime {
+    uint64_t runNum;
+    double logWeight;           // log likelihood ratio up to the horizon
+    uint32_t faultCount;
+    uint32_t reserved;
+};
+
+// a fault arrival: its type, and the parameters the type randomizes
+struct FaultLogRecord {
+    double hr;
+    double logWeight;           // log likelihood ratio up to this arrival
+    uint64_t addr;
+    uint32_t domain;
+    uint32_t affectedBlkCount;
+    uint32_t drawIndex;         // draws of the event before its decode
+    uint8_t pins[8];            // pin positions (numDQ of the type)
+    uint16_t typeID;            // fault factory type ID
+    uint8_t chip;
+    uint8_t beat;               // first beat
+};
+
+static_assert(sizeof(FaultLogRecord)==48, "FaultLogRecord must stay packed");
+
+//------------------------------------------------------------------------------
+// appends lifetimes; the header is completed by close()
+class FaultLogWriter {
+public:
+    FaultLogWriter() : file(NULL) {}
+    ~FaultLogWriter() { close(); }
+
+    bool open(const char *name, const FaultLogHeader &_header);
+    void close();
+    // runs [0, runEnd) are logged
+    void coverRuns(uint64_t runEnd) { if (runEnd>header.runCount) header.runCount = runEnd; }
+
+    // the faults of the current lifetime
+    std::vector<FaultLogRecord> faults;
+    void writeLifetime(uint64_t runNum, double logWeight);
+protected:
+    FILE *file;
+    FaultLogHeader header;
+};
+
+// read-only memory map of a log, with the lifetimes indexed by run
+class FaultLogReader {
+public:
+    FaultLogReader() : base(NULL), size(0) {}
+    ~FaultLogReader() { close(); }
+
+    // false (with a message): missing or malformed
+    bool open(const char *name);
+    void close();
+    const FaultLogHeader &getHeader() const { return *(const FaultLogHeader *) base; }
+
+    // the first lifetime at or after runNum (NULL: none)
+    const FaultLogLifetime *findLifetime(uint64_t runNum) const;
+    // the lifetime after a lifetime (NULL: none)
+    const FaultLogLifetime *nextLifetime(const FaultLogLifetime *lifetime) const;
+    static const FaultLogRecord *getFaults(const FaultLogLifetime *lifetime) { return (const FaultLogRecord *) (lifetime+1); }
+protected:
+    void *base;
+    size_t size;
+    std::vector<const FaultLogLifetime *> lifetimes;
+};
+
+#endif /* __FAULT_LOG_HH__ */
@@ -0,0 +1,124 @@
+#include "FaultRateInfo.hh"
+#include "Fault.hh"
+
+//------------------------------------------------------------------------------
+void FaultRateInfo::addFaultRate(std::string name, double rate) {
+    rateInfo.push_back(std::make_pair(name, rate));
+    rateProfiles.push_back(NULL);
+    totalRate += rate;
+    tablesValid = false;
+}
+
+void FaultRateInfo::setTypeBias(double bias) {
+    typeBias = bias;
+    tablesValid = false;
+}
+
+void FaultRateInfo::setRateProfile(const std::string &prefix, const RateProfile *profile) {
+    for (size_t i=0; i<rateInfo.size(); i++) {
+        if (rateInfo[i].first.compare(0, prefix.size(), prefix)==0) {
+            rateProfiles[i] = profile;
+        }
+    }
+    tablesValid = false;
+}
+
+double FaultRateInfo::getHazard(double hr) {
+    prepareTables();
+    double hazard = .0;
+    for (size_t g=0; g<groups.size(); g++) {
+        hazard += (groups[g].profile==NULL) ? groups[g].rate*hr : groups[g].rate*groups[g].profile->getIntegral(hr);
+    }
+    return hazard;
+}
+
+// a group in proportion to its rate at hr
+const FaultRateInfo::RateGroup &FaultRateInfo::pickRandomGroup(double hr) {
+    groupRates.resize(groups.size());
+    double rateSum = .0;
+    for (size_t g=0; g<groups.size(); g++) {
+        groupRates[g] = (groups[g].profile==NULL) ? groups[g].rate : groups[g].rate*groups[g].profile->getMultiplier(hr);
+        rateSum += groupRates[g];
+    }
+    double draw = randomGenerator.uniformReal() * rateSum;
+    size_t g = 0;
+    while ((g+1<groups.size()) && ((draw -= groupRates[g]) >= 0.)) {
+        g++;
+    }
+    return groups[g];
+}
+
+//------------------------------------------------------------------------------
+// one group of types per profile (in order of first use), each with its own
+// alias table
+void FaultRateInfo::buildAliasTable() {
+    groups.clear();
+    std::vector<int> groupOf(rateInfo.size());
+    for (size_t i=0; i<rateInfo.size(); i++) {
+        size_t g = 0;
+        while ((g<groups.size()) && (groups[g].profile!=rateProfiles[i])) {
+            g++;
+        }
+        if (g==groups.size()) {
+            RateGroup group = {rateProfiles[i], .0, std::vector<AliasEntry>()};
+            groups.push_back(group);
+        }
+        groups[g].rate += rateInfo[i].second;
+        groupOf[i] = g;
+    }
+    for (size_t g=0; g<groups.size(); g++) {
+        std::vector<int> members;
+        for (size_t i=0; i<rateInfo.size(); i++) {
+            if (groupOf[i]==(int) g) {
+                members.push_back(i);
+            }
+        }
+        buildAliasTable(members, groups[g]);
+    }
+}
+
+// Vose's alias method: every slot i keeps itself with probability prob and
+// hands the rest of its 1/n share to alias
+void FaultRateInfo::buildAliasTable(const std::vector<int> &members, RateGroup &group) {
+    int n = members.size();
+    std::vector<double> weight(n);
+    double totalWeight = .0;
+    for (int i=0; i<n; i++) {
+        const std::string &name = rateInfo[members[i]].first;
+        bool isMultiDQ = (name.find("-2p")!=std::string::npos) || (name.find("-3p")!=std::string::npos)
+                      || (name.find("-4p")!=std::string::npos) || (name.find("-np")!=std::string::npos);
+        weight[i] = (isMultiDQ) ? rateInfo[members[i]].second*typeBias : rateInfo[members[i]].second;
+        totalWeight += weight[i];
+    }
+
+    std::vector<AliasEntry> &aliasTable = group.aliasTable;
+    aliasTable.resize(n);
+    std::vector<double> scaled(n);
+    std::vector<int> small, large;
+    for (int i=0; i<n; i++) {
+        AliasEntry &entry = aliasTable[i];
+        entry.typeID = Fault::getFaultTypeID(rateInfo[members[i]].first);
+        assert(entry.typeID>=0);
+        entry.ratio = (typeBias==1.) ? 1. : (rateInfo[members[i]].second/group.rate) / (weight[i]/totalWeight);
+        entry.prob = 1.;
+        entry.alias = i;
+        scaled[i] = weight[i] * n / totalWeight;
+        if (scaled[i] < 1.) {
+            small.push_back(i);
+        } else {
+            large.push_back(i);
+        }
+    }
+    while (!small.empty() && !large.empty()) {
+        int s = small.back(); small.pop_back();
+        int l = large.back();
+        aliasTable[s].prob = scaled[s];
+        aliasTable[s].alias = l;
+        scaled[l] -= 1. - scaled[s];
+        if (scaled[l] < 1.) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // leftovers are 1 up to rounding
+}
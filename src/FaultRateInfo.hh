@@ -6,33 +6,72 @@
 #include <string>
 #include <iostream>
 #include <list>
+#include <vector>
 
 #include "common.hh"
 #include "Config.hh"
+#include "Random.hh"
+#include "RateProfile.hh"
 
 class FaultRateInfo {
 public:
-    FaultRateInfo() { totalRate = .0; }
+    FaultRateInfo() { totalRate = .0; typeBias = 1.; lastRatio = 1.; tablesValid = false; }
 public:
     double getTotalRate() { return totalRate; }
-    void addFaultRate(std::string name, double rate) {
-        rateInfo.push_back(std::make_pair(name, rate));
-        totalRate += rate;
-    }
-    std::string pickRandomType() {
-        double draw = (double)rand() / RAND_MAX;
-        double sum = .0;
-        for (auto it=rateInfo.cbegin(); it!=rateInfo.cend(); it++) {
-            sum += (*it).second;
-            if ((sum/totalRate) >= draw) {
-                return (*it).first;
-            }
-        }
-        assert(0);
+    void addFaultRate(std::string name, double rate);
+    // importance sampling: pick multi-DQ fault types (-2p/-3p/-4p/-np) bias
+    // times more often than their rates (1: no bias)
+    void setTypeBias(double bias);
+    // time dependence of the types whose name starts with prefix
+    // (NULL: constant; the profile is not owned)
+    void setRateProfile(const std::string &prefix, const RateProfile *profile);
+    bool isTimeVarying() { prepareTables(); return (groups.size()>1) || (!groups.empty() && (groups[0].profile!=NULL)); }
+    // expected fault count over [0, hr] (totalRate*hr when constant)
+    double getHazard(double hr);
+    // likelihood ratio (true / sampled probability) of the last picked type
+    double getLastRatio() { return lastRatio; }
+    // O(1) draw of a fault type ID arriving at hr (Walker/Vose alias method,
+    // one draw; one more to pick the profile group when there are several)
+    int pickRandomTypeID(double hr) {
+        prepareTables();
+        const RateGroup &group = (groups.size()>1) ? pickRandomGroup(hr) : groups[0];
+        const std::vector<AliasEntry> &aliasTable = group.aliasTable;
+        assert(!aliasTable.empty());
+        double draw = randomGenerator.uniformReal() * aliasTable.size();
+        int idx = (int) draw;
+        const AliasEntry &entry = aliasTable[idx];
+        int pick = ((draw-idx) < entry.prob) ? idx : entry.alias;
+        lastRatio = aliasTable[pick].ratio;
+        return aliasTable[pick].typeID;
     }
 protected:
-    std::list<std::pair<std::string, double>> rateInfo;
+    struct RateGroup;
+    const RateGroup &pickRandomGroup(double hr);
+    void buildAliasTable();
+    void buildAliasTable(const std::vector<int> &members, RateGroup &group);
+    // the groups and their alias tables are built on first use after a change
+    void prepareTables() { if (!tablesValid) { buildAliasTable(); tablesValid = true; } }
+protected:
+    struct AliasEntry {
+        double prob;        // probability to keep this slot
+        int alias;          // slot taken otherwise
+        int typeID;         // fault type ID of this slot
+        double ratio;       // true / sampled probability of this slot (within its group)
+    };
+    // the fault types sharing a rate profile
+    struct RateGroup {
+        const RateProfile *profile;
+        double rate;        // nominal rate
+        std::vector<AliasEntry> aliasTable;
+    };
+    std::vector<std::pair<std::string, double>> rateInfo;
+    std::vector<const RateProfile *> rateProfiles;  // per type
     double totalRate;
+    double typeBias;
+    std::vector<RateGroup> groups;
+    bool tablesValid;                   // groups match the rates, bias and profiles
+    std::vector<double> groupRates;     // scratch of pickRandomGroup()
+    double lastRatio;
 };
 
 class DefaultFaultRateInfo : public FaultRateInfo {
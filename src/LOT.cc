@@ -11,7 +11,7 @@ ErrorType LOTECC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
     // random data
     ECCWord dataMsg = {errorBlk.getBitN(), 0};
     for (int i=0; i<errorBlk.getChannelWidth(); i++) {
-        dataMsg.setSymbol(8, i, rand()%0x100);
+        dataMsg.setSymbol(8, i, randomGenerator.uniformInt(0x100));
     }
 
     ECCWord errorMsg = {errorBlk.getBitN(), 0};
@@ -40,16 +40,16 @@ ErrorType MultiECC::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
                         uint32_t errorChecksum = 0;
 
                         for (int j=0; j<256; j++) {
-                            uint16_t data = rand() % 0x10000;
+                            uint16_t data = randomGenerator.uniformInt(0x10000);
                             uint16_t error;
                             if (j==0) {
                                 error = decoded.getSymbol(16, (*it)->getChipID());
                             } else {
                                 if (!(*it)->getIsSingleDQ()) {
-                                    error = rand() % 0x10000;
+                                    error = randomGenerator.uniformInt(0x10000);
                                 } else {
                                     int pinLoc = (*it)->getPinID()%8;
-                                    error = ((rand()%2) << pinLoc) | (rand()%2 << (pinLoc+8));
+                                    error = (randomGenerator.uniformInt(2) << pinLoc) | (randomGenerator.uniformInt(2) << (pinLoc+8));
                                 }
                             }
                             origChecksum += data;
@@ -248,7 +248,7 @@ ErrorType QPC72bREGB::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
             }
         }
         if (overlapManyDQFaults.size()>0) {
-            int faultPos = rand()%overlapManyDQFaults.size();
+            int faultPos = randomGenerator.uniformInt(overlapManyDQFaults.size());
             int pos;
             for (auto it = overlapManyDQFaults.cbegin(); it != overlapManyDQFaults.cend();) {
                 if (pos==faultPos) {
@@ -275,7 +275,7 @@ ErrorType QPC72bREGB::decodeInternal(FaultDomain *fd, CacheLine &errorBlk) {
                 pos++;
             }
         } else if (overlapFewDQFaults.size()>0) {
-            int faultPos = rand()%overlapFewDQFaults.size();
+            int faultPos = randomGenerator.uniformInt(overlapFewDQFaults.size());
             int pos;
             for (auto it = overlapFewDQFaults.cbegin(); it != overlapFewDQFaults.cend();) {
                 if (pos==faultPos) {
@@ -0,0 +1,54 @@
+#include "Random.hh"
+
+//------------------------------------------------------------------------------
+thread_local RandomGenerator randomGenerator;
+
+//------------------------------------------------------------------------------
+// Philox-4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+void Philox4x32::block(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t x0 = ctr[0], x1 = ctr[1], x2 = ctr[2], x3 = ctr[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round=0; round<10; round++) {
+        uint64_t p0 = (uint64_t) 0xD2511F53u * x0;
+        uint64_t p1 = (uint64_t) 0xCD9E8D57u * x2;
+        uint32_t y0 = (uint32_t) (p1>>32) ^ x1 ^ k0;
+        uint32_t y1 = (uint32_t) p1;
+        uint32_t y2 = (uint32_t) (p0>>32) ^ x3 ^ k1;
+        uint32_t y3 = (uint32_t) p0;
+        x0 = y0; x1 = y1; x2 = y2; x3 = y3;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+    out[0] = x0; out[1] = x1; out[2] = x2; out[3] = x3;
+}
+
+//------------------------------------------------------------------------------
+// Threefry-4x32-20 (same paper), with the 64-bit key zero-extended to 128 bits
+static inline uint32_t rotl32(uint32_t x, int r) { return (x<<r) | (x>>(32-r)); }
+
+void Threefry4x32::block(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]) {
+    static const int ROT[8][2] = {{10, 26}, {11, 21}, {13, 27}, {23, 5},
+                                  { 6, 20}, {17, 11}, {25, 10}, {18, 20}};
+    uint32_t ks[5] = {key[0], key[1], 0, 0, 0x1BD11BDAu ^ key[0] ^ key[1]};
+    uint32_t x[4];
+    for (int i=0; i<4; i++) {
+        x[i] = ctr[i] + ks[i];
+    }
+    for (int round=0; round<20; round++) {
+        if ((round%2)==0) {
+            x[0] += x[1]; x[1] = rotl32(x[1], ROT[round%8][0]); x[1] ^= x[0];
+            x[2] += x[3]; x[3] = rotl32(x[3], ROT[round%8][1]); x[3] ^= x[2];
+        } else {
+            x[0] += x[3]; x[3] = rotl32(x[3], ROT[round%8][0]); x[3] ^= x[0];
+            x[2] += x[1]; x[1] = rotl32(x[1], ROT[round%8][1]); x[1] ^= x[2];
+        }
+        if ((round%4)==3) {     // key injection
+            int s = (round+1)/4;
+            for (int i=0; i<4; i++) {
+                x[i] += ks[(s+i)%5];
+            }
+            x[3] += s;
+        }
+    }
+    out[0] = x[0]; out[1] = x[1]; out[2] = x[2]; out[3] = x[3];
+}
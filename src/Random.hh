@@ -0,0 +1,97 @@
+#ifndef __RANDOM_HH__
+#define __RANDOM_HH__
+
+#include <stdint.h>
+#include <random>
+
+// counter-based bijection used by RandomGenerator
+// - default : Philox-4x32-10
+// - RANDOM_THREEFRY : Threefry-4x32-20
+//#define RANDOM_THREEFRY
+
+//------------------------------------------------------------------------------
+// Counter-based bijections: out = f_key(ctr)
+// - 128-bit counter, 64-bit key, 128-bit output
+struct Philox4x32 {
+    static void block(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]);
+};
+
+struct Threefry4x32 {
+    static void block(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]);
+};
+
+#ifdef RANDOM_THREEFRY
+typedef Threefry4x32 CounterRNG;
+#else
+typedef Philox4x32 CounterRNG;
+#endif
+
+//------------------------------------------------------------------------------
+// Random stream
+// - a draw is a pure function of (seed, run index, event index, draw index)
+//   -> any run (lifetime / scenario iteration) can be regenerated directly
+//      from its index, independent of the runs before it or of the thread
+//      that simulates it
+// - counter layout: [0] draw index, [1] event index, [2:3] run index
+// - usable as a URBG with the <random> distributions
+class RandomGenerator {
+public:
+    typedef uint32_t result_type;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    RandomGenerator() { seed(0); }
+
+public:
+    void seed(unsigned long long _seed) {
+        key[0] = (uint32_t) _seed;
+        key[1] = (uint32_t) (_seed>>32);
+        startRun(0);
+    }
+    void startRun(unsigned long long runIndex) {
+        ctr[2] = (uint32_t) runIndex;
+        ctr[3] = (uint32_t) (runIndex>>32);
+        startEvent(0);
+    }
+    void startEvent(unsigned eventIndex) {
+        ctr[1] = eventIndex;
+        ctr[0] = 0;
+        bufferPos = 4;
+    }
+    unsigned long long getSeed() const { return ((unsigned long long) key[1]<<32) | key[0]; }
+    unsigned long long getRunIndex() const { return ((unsigned long long) ctr[3]<<32) | ctr[2]; }
+    // 32-bit draws taken from the current event, and a jump to a draw of it
+    unsigned long long getDrawIndex() const { return (unsigned long long) ctr[0]*4 - (4-bufferPos); }
+    void setDrawIndex(unsigned long long drawIndex) {
+        ctr[0] = (uint32_t) (drawIndex/4);
+        bufferPos = 4;
+        for (unsigned i=0; i<drawIndex%4; i++) {
+            (*this)();
+        }
+    }
+
+    result_type operator()() {
+        if (bufferPos==4) {
+            CounterRNG::block(ctr, key, buffer);
+            ctr[0]++;
+            bufferPos = 0;
+        }
+        return buffer[bufferPos++];
+    }
+    unsigned long long next64() { unsigned long long hi = (*this)(); return (hi << 32) | (*this)(); }
+    // uniform integer in [0, n)
+    int uniformInt(int n) { return (int) (next64() % (unsigned long long) n); }
+    // uniform real in [0, 1)
+    double uniformReal() { return (next64()>>11) * (1.0/9007199254740992.0); }
+
+protected:
+    uint32_t key[2];
+    uint32_t ctr[4];
+    uint32_t buffer[4];
+    int bufferPos;
+};
+
+//------------------------------------------------------------------------------
+extern thread_local RandomGenerator randomGenerator;
+
+#endif /* __RANDOM_HH__ */
@@ -0,0 +1,51 @@
+#include <stdlib.h>
+
+#include "RateProfile.hh"
+
+static const double YEAR_HRS = 24*365;
+
+//------------------------------------------------------------------------------
+double YearlyProfile::getMultiplier(double hr) const {
+    size_t year = (size_t) (hr/YEAR_HRS);
+    return multipliers[(year < multipliers.size()) ? year : multipliers.size()-1];
+}
+
+double YearlyProfile::getIntegral(double hr) const {
+    double integral = 0.;
+    size_t year = 0;
+    for (; (year+1 < multipliers.size()) && ((year+1)*YEAR_HRS <= hr); year++) {
+        integral += multipliers[year]*YEAR_HRS;
+    }
+    return integral + multipliers[year]*(hr-year*YEAR_HRS);
+}
+
+//------------------------------------------------------------------------------
+RateProfile *RateProfile::parse(const std::string &spec) {
+    size_t colon = spec.find(':');
+    if (colon==std::string::npos) {
+        return NULL;
+    }
+    std::string kind = spec.substr(0, colon);
+    std::vector<double> params;
+    const char *str = spec.c_str()+colon+1;
+    while (*str!='\0') {
+        char *end;
+        double value = strtod(str, &end);
+        if ((end==str) || (value<0.) || ((*end!=',') && (*end!='\0'))) {
+            return NULL;
+        }
+        params.push_back(value);
+        str = (*end==',') ? end+1 : end;
+    }
+
+    if ((kind=="weibull") && (params.size()==2) && (params[0]>0.) && (params[1]>0.)) {
+        return new WeibullProfile(params[0], params[1]*YEAR_HRS);
+    }
+    if ((kind=="bathtub") && (params.size()==4) && (params[0]>0.) && (params[1]>0.) && (params[2]>0.) && (params[3]>0.)) {
+        return new BathtubProfile(params[0], params[1]*YEAR_HRS, params[2], params[3]*YEAR_HRS);
+    }
+    if ((kind=="years") && !params.empty()) {
+        return new YearlyProfile(params);
+    }
+    return NULL;
+}
@@ -0,0 +1,63 @@
+#ifndef __RATE_PROFILE_HH__
+#define __RATE_PROFILE_HH__
+
+#include <math.h>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Time dependence of a fault rate: the rate at hr is the nominal rate times
+// getMultiplier(hr) (NULL profile: constant, multiplier 1)
+class RateProfile {
+public:
+    RateProfile() {}
+    virtual ~RateProfile() {}
+public:
+    // rate multiplier at hr
+    virtual double getMultiplier(double hr) const = 0;
+    // its integral over [0, hr]
+    virtual double getIntegral(double hr) const = 0;
+
+    // weibull:shape,pivotYears | bathtub:shape,pivotYears,shape,pivotYears |
+    // years:m0,m1,... (NULL: malformed)
+    static RateProfile *parse(const std::string &spec);
+};
+
+// Weibull hazard, equal to the nominal rate at pivot hours
+// (shape < 1: infant mortality, 1: constant, > 1: wear-out)
+class WeibullProfile : public RateProfile {
+public:
+    WeibullProfile(double _shape, double _pivot) : shape(_shape), pivot(_pivot) {}
+
+    double getMultiplier(double hr) const { return pow(hr/pivot, shape-1.); }
+    double getIntegral(double hr) const { return pivot/shape*pow(hr/pivot, shape); }
+protected:
+    double shape;
+    double pivot;
+};
+
+// infant-mortality plus wear-out Weibull terms
+class BathtubProfile : public RateProfile {
+public:
+    BathtubProfile(double infantShape, double infantPivot, double wearShape, double wearPivot)
+    : infant(infantShape, infantPivot), wear(wearShape, wearPivot) {}
+
+    double getMultiplier(double hr) const { return infant.getMultiplier(hr) + wear.getMultiplier(hr); }
+    double getIntegral(double hr) const { return infant.getIntegral(hr) + wear.getIntegral(hr); }
+protected:
+    WeibullProfile infant;
+    WeibullProfile wear;
+};
+
+// a constant multiplier per year (the last one holds after it)
+class YearlyProfile : public RateProfile {
+public:
+    YearlyProfile(const std::vector<double> &_multipliers) : multipliers(_multipliers) {}
+
+    double getMultiplier(double hr) const;
+    double getIntegral(double hr) const;
+protected:
+    std::vector<double> multipliers;
+};
+
+#endif /* __RATE_PROFILE_HH__ */
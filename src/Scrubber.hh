@@ -1,36 +1,41 @@
 #ifndef __SCRUBBER_HH__
 #define __SCRUBBER_HH__
 
+#include <math.h>
 #include "DomainGroup.hh"
 
+// A scrubber removes the soft errors of a domain when a scrub of it completes.
+// Scrubs are events of the system simulation, scheduled for a domain only
+// while it holds a soft error (a scrub of a clean domain changes nothing).
 class Scrubber {
 public:
     Scrubber() {}
+    virtual ~Scrubber() {}
 public:
-    virtual void scrub(DomainGroup *dg, double hrs) = 0;
+    // completion time of the first scrub after hrs (INFINITY: never)
+    virtual double getNextScrubHr(double hrs) const = 0;
+    // a private copy for a worker thread
+    virtual Scrubber *clone() const = 0;
 };
 
 class NoScrubber : public Scrubber {
 public:
     NoScrubber() {}
 
-    void scrub(DomainGroup *dg, double hrs) { return; }
+    double getNextScrubHr(double hrs) const { return INFINITY; }
+    Scrubber *clone() const { return new NoScrubber(); }
 };
 
+// every period hours: a soft error arriving at hrs is gone from the start of
+// the next period
 class PeriodicScrubber : public Scrubber {
 public:
-    PeriodicScrubber(double _period) : period(_period), prevScrubSection(0) { }
+    PeriodicScrubber(double _period) : period(_period) { }
 
-    void scrub(DomainGroup *dg, double hrs) {
-        int curScrubSection = (int) hrs / period;
-        if (curScrubSection != prevScrubSection) {
-            dg->scrub();
-            prevScrubSection = curScrubSection;
-        }
-    }
+    double getNextScrubHr(double hrs) const { return (floor(hrs/period)+1)*period; }
+    Scrubber *clone() const { return new PeriodicScrubber(period); }
 protected:
     double period;
-    int prevScrubSection;
 };
 
 #endif /* __SCRUBBER_HH__ */
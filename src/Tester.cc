@@ -2,12 +2,20 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <math.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <thread>
+#include <vector>
+#include <algorithm>
 
 #include "Config.hh"
 #include "Tester.hh"
 #include "Scrubber.hh"
 #include "FaultDomain.hh"
 #include "DomainGroup.hh"
+#include "Random.hh"
 #include "codec.hh"
 #include "rs.hh"
 
@@ -25,224 +33,1640 @@ char errorName[][10] = {"NE ",
 
 						};
 
+//------------------------------------------------------------------------------
+// Simulate the runs of this shard [runBegin, runEnd) of [0, runCnt), with
+// resume from a checkpoint, and write the summary to logName (+ shard suffix)
+void Tester::run(const std::string &logName, long runCnt) {
+    std::string name = logName;
+    long runBegin = 0;
+    long runEnd = runCnt;
+    bool isShard = (shardCount>1) || (firstRun>0);
+    if (isShard) {
+        assert((shardID>=0) && (shardID<shardCount) && (firstRun<=runCnt));
+        runBegin = firstRun + (runCnt-firstRun)*shardID/shardCount;
+        runEnd = firstRun + (runCnt-firstRun)*(shardID+1)/shardCount;
+        char suffix[64];
+        sprintf(suffix, ".runs%ld-%ld", runBegin, runEnd);
+        name = name+suffix;
+    }
+
+    long runNum = runBegin;
+    std::string checkpointName = name+".ckpt";
+    bool resumed = resume && loadCheckpoint(checkpointName, runBegin, runEnd, &runNum);
+    if (resumed) {
+        printf("Resuming after %ld runs\n", runNum-runBegin);
+    }
+    FILE *fd = fopen(name.c_str(), resumed ? "a" : "w");
+    assert(fd!=NULL);
+
+    runNum = runStops(fd, checkpointName, runBegin, runNum, runEnd);
+    printSummary(fd, runNum-runBegin);
+
+    fclose(fd);
+
+    if (isShard) {
+        savePartial(name+".part", logName, runBegin, runNum);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Run [runNum, runEnd) in stops. At each stop, the periodic summary is printed
+// and a checkpoint is saved. As every run draws from its own run-indexed
+// random stream, (runNum, counters) is the complete simulation state.
+// Returns the run index it stopped at (runEnd, or earlier once precise).
+long Tester::runStops(FILE *fd, const std::string &checkpointName, long runBegin, long runNum, long runEnd) {
+    while (runNum<runEnd) {
+        if (isPrecise(runNum-runBegin)) {
+            printf("Reached the target precision after %ld runs\n", runNum-runBegin);
+            break;
+        }
+
+        long stop = nextStop(runBegin, runNum, runEnd);
+        runRange(runNum, stop);
+        runNum = stop;
+
+        long runDone = runNum-runBegin;
+        if ((runNum<runEnd) && ((runDone==100) || (runDone%100000000==0))) {
+            printSummary(fd, runDone);
+        }
+        if (checkpointInterval>0) {
+            saveCheckpoint(checkpointName, runNum);
+        }
+    }
+    return runNum;
+}
+
+long Tester::nextStop(long runBegin, long runNum, long runEnd) {
+    long runDone = runNum-runBegin;
+    long stop = (runDone/100000000+1)*100000000;
+    if (runDone<100) {
+        stop = 100;
+    }
+    if ((checkpointInterval>0) && ((runDone/checkpointInterval+1)*checkpointInterval < stop)) {
+        stop = (runDone/checkpointInterval+1)*checkpointInterval;
+    }
+    // check the precision after every ~10% more runs
+    if ((relCI>0.) && (runDone>=100)) {
+        long step = (runDone/10 > 1000) ? runDone/10 : 1000;
+        if (runDone+step < stop) {
+            stop = runDone+step;
+        }
+    }
+    return (runBegin+stop < runEnd) ? runBegin+stop : runEnd;
+}
+
+//------------------------------------------------------------------------------
+void Tester::setPrecision(double _relCI, double _confidence, const std::string &metrics) {
+    assert((_confidence>0.) && (_confidence<1.));
+    relCI = _relCI;
+    confidence = _confidence;
+
+    // two-sided z score: solve erfc(z/sqrt(2)) = 1-confidence by bisection
+    double lo = 0., hi = 40.;
+    for (int i=0; i<100; i++) {
+        double mid = (lo+hi)/2;
+        if (erfc(mid/sqrt(2.)) > 1.-confidence) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    zScore = (lo+hi)/2;
+
+    ciMetrics.clear();
+    size_t pos = 0;
+    while (pos<=metrics.size()) {
+        size_t comma = metrics.find(',', pos);
+        if (comma==std::string::npos) {
+            comma = metrics.size();
+        }
+        if (comma>pos) {
+            ciMetrics.push_back(metrics.substr(pos, comma-pos));
+        }
+        pos = comma+1;
+    }
+}
+
+// Wilson score interval of count/runNum
+void Tester::getInterval(long count, long runNum, double *lower, double *upper) {
+    if (runNum==0) {
+        *lower = 0.;
+        *upper = 1.;
+        return;
+    }
+    double n = runNum;
+    double p = count/n;
+    double z2 = zScore*zScore;
+    double denom = 1.+z2/n;
+    double center = (p+z2/(2*n))/denom;
+    double half = zScore*sqrt(p*(1-p)/n + z2/(4*n*n))/denom;
+    *lower = (center-half > 0.) ? center-half : 0.;
+    *upper = (center+half < 1.) ? center+half : 1.;
+}
+
+// normal-approximation interval of a weighted estimate weight/runNum
+void Tester::getWeightedInterval(double weight, double weight2, long runNum, double *lower, double *upper) {
+    if (runNum==0) {
+        *lower = 0.;
+        *upper = 1.;
+        return;
+    }
+    double estimate = weight/runNum;
+    double variance = weight2/runNum - estimate*estimate;
+    double half = zScore*sqrt(((variance>0.) ? variance : 0.)/runNum);
+    *lower = (estimate-half > 0.) ? estimate-half : 0.;
+    *upper = estimate+half;
+}
+
+// true if every requested metric is within +-relCI (relative) of its estimate
+// - a metric never observed is never precise (runs until the hard cap)
+bool Tester::isPrecise(long runNum) {
+    if ((relCI<=0.) || (runNum==0)) {
+        return false;
+    }
+    std::vector<Metric> list;
+    listMetrics(list);
+    for (size_t i=0; i<ciMetrics.size(); i++) {
+        // (one per scheme with several schemes)
+        bool found = false;
+        for (size_t j=0; j<list.size(); j++) {
+            if (ciMetrics[i]!=list[j].name) {
+                continue;
+            }
+            found = true;
+            if (list[j].count==0) {
+                return false;
+            }
+            double estimate, lower, upper;
+            if (isWeighted()) {
+                getWeightedInterval(list[j].weight, list[j].weight2, runNum, &lower, &upper);
+                estimate = list[j].weight/runNum;
+            } else {
+                getInterval(list[j].count, runNum, &lower, &upper);
+                estimate = (double) list[j].count/runNum;
+            }
+            if ((upper-lower)/2 > relCI*estimate) {
+                return false;
+            }
+        }
+        if (!found) {
+            printf("Unknown metric %s (", ciMetrics[i].c_str());
+            for (size_t j=0; j<list.size(); j++) {
+                printf(" %s", list[j].name);
+            }
+            printf(" )\n");
+            exit(1);
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void Tester::resetCounters() {
+    std::vector<CounterArray> list;
+    listCounters(list);
+    for (size_t i=0; i<list.size(); i++) {
+        for (int j=0; j<list[i].size; j++) {
+            list[i].data[j] = 0l;
+        }
+    }
+    std::vector<WeightArray> weights;
+    listWeights(weights);
+    for (size_t i=0; i<weights.size(); i++) {
+        for (int j=0; j<weights[i].size; j++) {
+            weights[i].data[j] = 0.;
+        }
+    }
+}
+
+void Tester::mergeCounters(Tester *other) {
+    std::vector<CounterArray> list, otherList;
+    listCounters(list);
+    other->listCounters(otherList);
+    assert(list.size()==otherList.size());
+    for (size_t i=0; i<list.size(); i++) {
+        for (int j=0; j<list[i].size; j++) {
+            list[i].data[j] += otherList[i].data[j];
+        }
+    }
+    std::vector<WeightArray> weights, otherWeights;
+    listWeights(weights);
+    other->listWeights(otherWeights);
+    assert(weights.size()==otherWeights.size());
+    for (size_t i=0; i<weights.size(); i++) {
+        for (int j=0; j<weights[i].size; j++) {
+            weights[i].data[j] += otherWeights[i].data[j];
+        }
+    }
+}
+
+void Tester::writeCounters(FILE *fd) {
+    std::vector<CounterArray> list;
+    listCounters(list);
+    for (size_t i=0; i<list.size(); i++) {
+        fwrite(list[i].data, sizeof(long), list[i].size, fd);
+    }
+    std::vector<WeightArray> weights;
+    listWeights(weights);
+    for (size_t i=0; i<weights.size(); i++) {
+        fwrite(weights[i].data, sizeof(double), weights[i].size, fd);
+    }
+}
+
+bool Tester::readCounters(FILE *fd) {
+    std::vector<CounterArray> list;
+    listCounters(list);
+    for (size_t i=0; i<list.size(); i++) {
+        if (fread(list[i].data, sizeof(long), list[i].size, fd)!=(size_t) list[i].size) {
+            return false;
+        }
+    }
+    std::vector<WeightArray> weights;
+    listWeights(weights);
+    for (size_t i=0; i<weights.size(); i++) {
+        if (fread(weights[i].data, sizeof(double), weights[i].size, fd)!=(size_t) weights[i].size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// checkpoint file
+// - header : magic (8B), version (4B), seed (8B), # of completed runs (8B),
+//            configuration length (4B) and string (getConfig)
+// - body   : counters (writeCounters)
+static const char CHECKPOINT_MAGIC[8] = {'E', 'C', 'C', 'C', 'K', 'P', 'T', '\0'};
+static const uint32_t CHECKPOINT_VERSION = 3;
+
+void Tester::saveCheckpoint(const std::string &name, long runNum) {
+    // write to a temporary file and rename it, so that a crash while
+    // writing never destroys the previous checkpoint
+    std::string tmpName = name+".tmp";
+    FILE *fd = fopen(tmpName.c_str(), "wb");
+    assert(fd!=NULL);
+
+    uint64_t seed64 = seed;
+    int64_t runNum64 = runNum;
+    std::string config = getConfig();
+    uint32_t configLen = config.size();
+    fwrite(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC), 1, fd);
+    fwrite(&CHECKPOINT_VERSION, sizeof(CHECKPOINT_VERSION), 1, fd);
+    fwrite(&seed64, sizeof(seed64), 1, fd);
+    fwrite(&runNum64, sizeof(runNum64), 1, fd);
+    fwrite(&configLen, sizeof(configLen), 1, fd);
+    fwrite(config.data(), 1, configLen, fd);
+    writeCounters(fd);
+
+    fflush(fd);
+    bool ok = !ferror(fd);
+    fclose(fd);
+    if (!ok || (rename(tmpName.c_str(), name.c_str())!=0)) {
+        printf("Failed to write checkpoint %s\n", name.c_str());
+    }
+}
+
+bool Tester::loadCheckpoint(const std::string &name, long runBegin, long runEnd, long *runNum) {
+    FILE *fd = fopen(name.c_str(), "rb");
+    if (fd==NULL) {
+        printf("No checkpoint %s, starting from the beginning\n", name.c_str());
+        return false;
+    }
+
+    char magic[8];
+    uint32_t version;
+    uint64_t seed64;
+    int64_t runNum64;
+    uint32_t configLen;
+    std::string config;
+    bool ok = (fread(magic, sizeof(magic), 1, fd)==1)
+           && (memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic))==0)
+           && (fread(&version, sizeof(version), 1, fd)==1)
+           && (version==CHECKPOINT_VERSION)
+           && (fread(&seed64, sizeof(seed64), 1, fd)==1)
+           && (fread(&runNum64, sizeof(runNum64), 1, fd)==1)
+           && (fread(&configLen, sizeof(configLen), 1, fd)==1)
+           && (configLen<=4096);
+    if (ok) {
+        config.resize(configLen);
+        ok = (fread(&config[0], 1, configLen, fd)==configLen);
+    }
+    // the counters only mean the same under the same configuration
+    if (ok && (config!=getConfig())) {
+        fclose(fd);
+        printf("Checkpoint %s was taken with another configuration (%s)\n", name.c_str(), config.c_str());
+        exit(1);
+    }
+    ok = ok && readCounters(fd) && (fgetc(fd)==EOF);
+    fclose(fd);
+
+    if (!ok) {
+        printf("Invalid checkpoint %s\n", name.c_str());
+        exit(1);
+    }
+    if (seed64!=seed) {
+        printf("Checkpoint %s was taken with seed %llu\n", name.c_str(), (unsigned long long) seed64);
+        exit(1);
+    }
+    if ((runNum64<runBegin) || (runNum64>runEnd)) {
+        printf("Checkpoint %s is outside of runs [%ld, %ld)\n", name.c_str(), runBegin, runEnd);
+        exit(1);
+    }
+    *runNum = runNum64;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// partial result of a shard (text)
+//   ECC-PARTIAL <version>
+//   type <system|scenario>
+//   name <log file name of the whole experiment>
+//   seed <seed>
+//   runs <runBegin> <runEnd>
+//   config <tester-specific configuration (getConfig)>
+//   <counter name> <size> <values> ...
+//   <weight name> <size> <values> ...
+static const int PARTIAL_VERSION = 3;
+
+void Tester::savePartial(const std::string &name, const std::string &logName, long runBegin, long runEnd) {
+    FILE *fd = fopen(name.c_str(), "w");
+    assert(fd!=NULL);
+
+    fprintf(fd, "ECC-PARTIAL %d\n", PARTIAL_VERSION);
+    fprintf(fd, "type %s\n", getType());
+    fprintf(fd, "name %s\n", logName.c_str());
+    fprintf(fd, "seed %llu\n", seed);
+    fprintf(fd, "runs %ld %ld\n", runBegin, runEnd);
+    fprintf(fd, "config %s\n", getConfig().c_str());
+
+    std::vector<CounterArray> list;
+    listCounters(list);
+    for (size_t i=0; i<list.size(); i++) {
+        fprintf(fd, "%s %d", list[i].name, list[i].size);
+        for (int j=0; j<list[i].size; j++) {
+            fprintf(fd, " %ld", list[i].data[j]);
+        }
+        fprintf(fd, "\n");
+    }
+    std::vector<WeightArray> weights;
+    listWeights(weights);
+    for (size_t i=0; i<weights.size(); i++) {
+        fprintf(fd, "%s %d", weights[i].name, weights[i].size);
+        for (int j=0; j<weights[i].size; j++) {
+            fprintf(fd, " %.17g", weights[i].data[j]);
+        }
+        fprintf(fd, "\n");
+    }
+    fclose(fd);
+}
+
+void Tester::mergeShards(int partCount, char **partNames) {
+    Tester *total = NULL;
+    char logName[1024], type[64];
+    unsigned long long totalSeed = 0;
+    std::string totalConfig;
+    std::vector<std::pair<long, long> > ranges;
+
+    for (int i=0; i<partCount; i++) {
+        FILE *fd = fopen(partNames[i], "r");
+        if (fd==NULL) {
+            printf("Cannot open %s\n", partNames[i]);
+            exit(1);
+        }
+
+        int version;
+        char partType[64], partName[1024];
+        unsigned long long partSeed;
+        long runBegin, runEnd;
+        char config[4096];
+        bool ok = (fscanf(fd, "ECC-PARTIAL %d ", &version)==1) && (version==PARTIAL_VERSION)
+               && (fscanf(fd, "type %63s ", partType)==1)
+               && (fscanf(fd, "name %1023s ", partName)==1)
+               && (fscanf(fd, "seed %llu ", &partSeed)==1)
+               && (fscanf(fd, "runs %ld %ld ", &runBegin, &runEnd)==2)
+               && (fgets(config, sizeof(config), fd)!=NULL) && (strncmp(config, "config ", 7)==0);
+        if (ok) {
+            config[strcspn(config, "\n")] = '\0';
+            memmove(config, config+7, strlen(config+7)+1);
+        }
+
+        Tester *part = NULL;
+        if (ok) {
+            if (strcmp(partType, "system")==0) {
+                part = new TesterSystem();
+            } else if (strcmp(partType, "scenario")==0) {
+                part = new TesterScenario();
+            } else {
+                ok = false;
+            }
+        }
+        if (ok) {
+            ok = part->setConfig(config);
+        }
+        if (ok) {
+            part->resetCounters();
+            std::vector<CounterArray> list;
+            part->listCounters(list);
+            for (size_t j=0; ok && (j<list.size()); j++) {
+                char counterName[64];
+                int size;
+                ok = (fscanf(fd, "%63s %d", counterName, &size)==2)
+                  && (strcmp(counterName, list[j].name)==0) && (size==list[j].size);
+                for (int k=0; ok && (k<size); k++) {
+                    ok = (fscanf(fd, "%ld", &list[j].data[k])==1);
+                }
+            }
+            std::vector<WeightArray> weights;
+            part->listWeights(weights);
+            for (size_t j=0; ok && (j<weights.size()); j++) {
+                char weightName[64];
+                int size;
+                ok = (fscanf(fd, "%63s %d", weightName, &size)==2)
+                  && (strcmp(weightName, weights[j].name)==0) && (size==weights[j].size);
+                for (int k=0; ok && (k<size); k++) {
+                    ok = (fscanf(fd, "%lf", &weights[j].data[k])==1);
+                }
+            }
+        }
+        fclose(fd);
+        if (!ok) {
+            printf("Invalid partial result %s\n", partNames[i]);
+            exit(1);
+        }
+
+        if (total==NULL) {
+            total = part;
+            strcpy(logName, partName);
+            strcpy(type, partType);
+            totalSeed = partSeed;
+            totalConfig = config;
+        } else {
+            if ((strcmp(logName, partName)!=0) || (strcmp(type, partType)!=0) || (totalSeed!=partSeed)
+             || (totalConfig!=config)) {
+                printf("%s belongs to a different experiment (%s, seed %llu)\n", partNames[i], partName, partSeed);
+                exit(1);
+            }
+            total->mergeCounters(part);
+            delete part;
+        }
+        ranges.push_back(std::make_pair(runBegin, runEnd));
+    }
+    if (total==NULL) {
+        printf("No partial result to merge\n");
+        exit(1);
+    }
+
+    // shards must not overlap, and should cover [0, runCnt)
+    std::sort(ranges.begin(), ranges.end());
+    // - runCnt: runs simulated, prevEnd: end of the previous range
+    long runCnt = 0;
+    long prevEnd = 0;
+    for (size_t i=0; i<ranges.size(); i++) {
+        if (ranges[i].first<prevEnd) {
+            printf("Runs [%ld, %ld) and [%ld, %ld) overlap\n", ranges[i-1].first, ranges[i-1].second, ranges[i].first, ranges[i].second);
+            exit(1);
+        }
+        if (ranges[i].first!=prevEnd) {
+            printf("Warning: runs [%ld, %ld) are missing\n", prevEnd, ranges[i].first);
+        }
+        runCnt += ranges[i].second-ranges[i].first;
+        prevEnd = ranges[i].second;
+    }
+
+    FILE *fd = fopen(logName, "w");
+    assert(fd!=NULL);
+    total->printSummary(fd, runCnt);
+    fclose(fd);
+    printf("Merged %d partial results (%ld runs) into %s\n", partCount, runCnt, logName);
+
+    delete total;
+}
+
 //------------------------------------------------------------------------------
 void TesterSystem::reset() {
-    for (int i=0; i<MAX_YEAR; i++) {
-        RetireCntYear[i] = 0l;
-        DUECntYear[i] = 0l;
-        SDCCntYear[i] = 0l;
+    resetCounters();
+}
+
+void TesterSystem::resizeCounters() {
+    int size = getColumnCount()*MAX_YEAR;
+    columnAlive.assign(getColumnCount(), 1);
+    RetireCntYear.assign(size, 0l);
+    DUECntYear.assign(size, 0l);
+    SDCCntYear.assign(size, 0l);
+#ifdef DUE_BREAKDOWN
+    DUE_ParityYear.assign(size, 0l);
+    DUE_NoErasureYear.assign(size, 0l);
+    SDC_ErasureYear.assign(size, 0l);
+#endif
+    RetireWeightYear.assign(size, 0.);
+    RetireWeight2Year.assign(size, 0.);
+    DUEWeightYear.assign(size, 0.);
+    DUEWeight2Year.assign(size, 0.);
+    SDCWeightYear.assign(size, 0.);
+    SDCWeight2Year.assign(size, 0.);
 #ifdef DUE_BREAKDOWN
-        DUE_ParityYear[i] = 0l;
-        DUE_NoErasureYear[i] = 0l;
-        SDC_ErasureYear[i] = 0l;
+    DUE_ParityWeightYear.assign(size, 0.);
+    DUE_ParityWeight2Year.assign(size, 0.);
+    DUE_NoErasureWeightYear.assign(size, 0.);
+    DUE_NoErasureWeight2Year.assign(size, 0.);
+    SDC_ErasureWeightYear.assign(size, 0.);
+    SDC_ErasureWeight2Year.assign(size, 0.);
 #endif
-	}
 }
 
 //------------------------------------------------------------------------------
-void TesterSystem::printSummary(FILE *fd, long runNum) {
-    fprintf(fd, "After %ld runs\n", runNum);
-    fprintf(fd, "Retire\n");
-    for (int yr=1; yr<MAX_YEAR; yr++) {
-        fprintf(fd, "%.11f\n", (double)RetireCntYear[yr]/runNum);
+// per year, one column per retirement threshold
+void TesterSystem::printOutcome(FILE *fd, const char *name, std::vector<long> &cnt, std::vector<double> &weight, std::vector<double> &weight2, long runNum) {
+    double lower, upper;
+    fprintf(fd, "%s", name);
+    for (size_t t=0; t<retireThresholds.size(); t++) {
+        fprintf(fd, "\tthreshold %-20llu", retireThresholds[t]);
     }
-    fprintf(fd, "DUE\n");
+    fprintf(fd, "\n");
     for (int yr=1; yr<MAX_YEAR; yr++) {
-        fprintf(fd, "%.11f\n", (double)DUECntYear[yr]/runNum);
+        for (int column=0; column<getColumnCount(); column++) {
+            int i = column*MAX_YEAR+yr;
+            if (column>0) {
+                fprintf(fd, "\t");
+            }
+            if (isWeighted()) {
+                getWeightedInterval(weight[i], weight2[i], runNum, &lower, &upper);
+                fprintf(fd, "%.11f\t[%.11f, %.11f]", weight[i]/runNum, lower, upper);
+            } else {
+                getInterval(cnt[i], runNum, &lower, &upper);
+                fprintf(fd, "%.11f\t[%.11f, %.11f]", (double)cnt[i]/runNum, lower, upper);
+            }
+        }
+        fprintf(fd, "\n");
     }
+}
+
+void TesterSystem::printSummary(FILE *fd, long runNum) {
+    fprintf(fd, "After %ld runs (%g%% confidence intervals)\n", runNum, confidence*100);
+    printOutcome(fd, "Retire", RetireCntYear, RetireWeightYear, RetireWeight2Year, runNum);
+    printOutcome(fd, "DUE", DUECntYear, DUEWeightYear, DUEWeight2Year, runNum);
 #ifdef DUE_BREAKDOWN
-    fprintf(fd, "DUE_Parity\n");
-    for (int yr=1; yr<MAX_YEAR; yr++) {
-        fprintf(fd, "%.11f\n", (double)DUE_ParityYear[yr]/runNum);
-    }
-    fprintf(fd, "DUE_NoErasure\n");
-    for (int yr=1; yr<MAX_YEAR; yr++) {
-        fprintf(fd, "%.11f\n", (double)DUE_NoErasureYear[yr]/runNum);
-    }
+    printOutcome(fd, "DUE_Parity", DUE_ParityYear, DUE_ParityWeightYear, DUE_ParityWeight2Year, runNum);
+    printOutcome(fd, "DUE_NoErasure", DUE_NoErasureYear, DUE_NoErasureWeightYear, DUE_NoErasureWeight2Year, runNum);
 #endif
-    fprintf(fd, "SDC\n");
-    for (int yr=1; yr<MAX_YEAR; yr++) {
-        fprintf(fd, "%.11f\n", (double)SDCCntYear[yr]/runNum);
-    }
+    printOutcome(fd, "SDC", SDCCntYear, SDCWeightYear, SDCWeight2Year, runNum);
 #ifdef DUE_BREAKDOWN
-    fprintf(fd, "SDC_Erasure\n");
-    for (int yr=1; yr<MAX_YEAR; yr++) {
-        fprintf(fd, "%.11f\n", (double)SDC_ErasureYear[yr]/runNum);
-    }
+    printOutcome(fd, "SDC_Erasure", SDC_ErasureYear, SDC_ErasureWeightYear, SDC_ErasureWeight2Year, runNum);
 #endif
+
+    // variance diagnostics
+    // - mean weight should be ~1, and the effective sample size close to
+    //   runNum; otherwise the sampling parameters are too aggressive
+    // - variance reduction: plain-sampling variance / weighted variance
+    if (isWeighted()) {
+        fprintf(fd, "Importance sampling (rate x%g, multi-DQ type bias x%g)\n", rateScale, typeBias);
+        fprintf(fd, "mean weight %.6f, effective sample size %.1f\n", weightSum[0]/runNum, weightSum[0]*weightSum[0]/weightSum2[0]);
+        std::vector<Metric> list;
+        listMetrics(list);
+        for (size_t i=0; i<list.size(); i++) {
+            double estimate = list[i].weight/runNum;
+            double variance = (list[i].weight2/runNum - estimate*estimate)/runNum;
+            fprintf(fd, "%s\t%ld hits", list[i].name, list[i].count);
+            if (!retireThresholds.empty()) {
+                fprintf(fd, " (threshold %llu)", retireThresholds[i/(list.size()/retireThresholds.size())]);
+            }
+            if ((list[i].count>1) && (variance>0.)) {
+                fprintf(fd, ", relative std. error %.4f, variance reduction x%.1f", sqrt(variance)/estimate, estimate*(1-estimate)/runNum/variance);
+            }
+            fprintf(fd, "\n");
+        }
+    }
     fflush(fd);
 }
 
+// sampling <rate scale> <type bias> retire <count> <threshold> ...
+std::string TesterSystem::getConfig() {
+    char buffer[128];
+    sprintf(buffer, "sampling %.17g %.17g retire %d", rateScale, typeBias, (int) retireThresholds.size());
+    std::string config = buffer;
+    for (size_t t=0; t<retireThresholds.size(); t++) {
+        sprintf(buffer, " %llu", retireThresholds[t]);
+        config = config+buffer;
+    }
+    return config;
+}
+
+bool TesterSystem::setConfig(const std::string &config) {
+    int thresholdCount, pos;
+    if ((sscanf(config.c_str(), "sampling %lf %lf retire %d%n", &rateScale, &typeBias, &thresholdCount, &pos)!=3) || (thresholdCount<0)) {
+        return false;
+    }
+    std::vector<unsigned long long> thresholds(thresholdCount);
+    const char *str = config.c_str()+pos;
+    for (int t=0; t<thresholdCount; t++) {
+        int len;
+        if (sscanf(str, " %llu%n", &thresholds[t], &len)!=1) {
+            return false;
+        }
+        str += len;
+    }
+    setRetireSweep(thresholds);
+    return true;
+}
+
+void TesterSystem::listMetrics(std::vector<Metric> &list) {
+    // probability of each outcome within the lifetime (per column)
+    list.clear();
+    for (int column=0; column<getColumnCount(); column++) {
+        int i = column*MAX_YEAR+MAX_YEAR-1;
+        Metric metrics[] = {{"Retire", RetireCntYear[i], RetireWeightYear[i], RetireWeight2Year[i]},
+                            {"DUE", DUECntYear[i], DUEWeightYear[i], DUEWeight2Year[i]},
+                            {"SDC", SDCCntYear[i], SDCWeightYear[i], SDCWeight2Year[i]}};
+        list.insert(list.end(), metrics, metrics+sizeof(metrics)/sizeof(Metric));
+    }
+}
+
 //------------------------------------------------------------------------------
-double TesterSystem::advance(double faultRate) {
-    double result = -log(1.0f - (double) rand() / ((long long) RAND_MAX+1)) / faultRate;
-    //printf("- %f\n", result);
-    return result;
+// Time-varying rates: arrivals by inversion of the cumulative hazard of the
+// group (expected arrivals since 0), integrated exactly by the profiles.
+// It is tabulated on HAZARD_CELL-hour cells up to the horizon to bracket an
+// inversion: a binary search over the table, then a root search on the exact
+// hazard within the cell (so that arrival times and the instantaneous rates
+// the fault types are picked with agree, e.g. near 0 for Weibull shape < 1)
+static const double HAZARD_CELL = 12.;
+static const double HAZARD_TOLERANCE_HRS = 1e-6;
+
+void TesterSystem::setupRates() {
+    for (size_t i=0; i<rateProfiles.size(); i++) {
+        dg->setRateProfile(rateProfiles[i].first, rateProfiles[i].second);
+    }
+    faultRate = dg->getFaultRate();
+    hazardTable.clear();
+    if (dg->isTimeVarying()) {
+        double horizon = (MAX_YEAR-1)*24*365;
+        int cellCount = (int) ceil(horizon/HAZARD_CELL);
+        hazardTable.resize(cellCount+1);
+        for (int i=0; i<=cellCount; i++) {
+            hazardTable[i] = dg->getHazard(i*HAZARD_CELL);
+        }
+    }
+}
+
+double TesterSystem::getHazard(double hr) {
+    return hazardTable.empty() ? faultRate*hr : dg->getHazard(hr);
+}
+
+// the group fault rate averaged over [from, to]
+double TesterSystem::getMeanRate(double from, double to) {
+    if (hazardTable.empty() || !(to > from)) {
+        return faultRate;
+    }
+    return (getHazard(to)-getHazard(from)) / (to-from);
+}
+
+// the time the cumulative hazard reaches hazard (INFINITY: beyond the table)
+double TesterSystem::invertHazard(double hazard) {
+    int i = std::upper_bound(hazardTable.begin(), hazardTable.end(), hazard) - hazardTable.begin();
+    if (i==(int) hazardTable.size()) {
+        return INFINITY;
+    }
+    if (i==0) {
+        return 0.;
+    }
+    // Illinois regula falsi, from the linear interpolation of the cell
+    double lo = (i-1)*HAZARD_CELL, loDiff = hazardTable[i-1]-hazard;
+    double hi = i*HAZARD_CELL, hiDiff = hazardTable[i]-hazard;
+    int side = 0;
+    while (hi-lo > HAZARD_TOLERANCE_HRS) {
+        double hr = lo - loDiff*(hi-lo)/(hiDiff-loDiff);
+        double diff = dg->getHazard(hr)-hazard;
+        if (diff==0.) {
+            return hr;
+        }
+        if (diff < 0.) {
+            lo = hr;
+            loDiff = diff;
+            hiDiff *= (side<0) ? .5 : 1.;
+            side = -1;
+        } else {
+            hi = hr;
+            hiDiff = diff;
+            loDiff *= (side>0) ? .5 : 1.;
+            side = 1;
+        }
+    }
+    return lo - loDiff*(hi-lo)/(hiDiff-loDiff);
+}
+
+// the next arrival after hr (at rateScale times the rates)
+double TesterSystem::advance(double hr) {
+    double draw = -log(1.0 - randomGenerator.uniformReal());
+    if (hazardTable.empty()) {
+        double rate = faultRate*rateScale;
+        return hr + draw / rate;
+    }
+    return invertHazard(getHazard(hr) + draw/rateScale);
+}
+
+// the first arrival of a lifetime known to have one within limit
+// (first arrival conditioned on [0, limit])
+double TesterSystem::advanceWithin(double limit) {
+    double result;
+    if (hazardTable.empty()) {
+        double rate = faultRate*rateScale;
+        result = -log(1.0 + randomGenerator.uniformReal()*expm1(-rate*limit)) / rate;
+    } else {
+        result = invertHazard(-log(1.0 + randomGenerator.uniformReal()*expm1(-rateScale*getHazard(limit))) / rateScale);
+    }
+    return (result < limit) ? result : limit;
+}
+
+//------------------------------------------------------------------------------
+void TesterSystem::listCounters(std::vector<CounterArray> &list) {
+    int size = getColumnCount()*MAX_YEAR;
+    CounterArray counters[] = {{"Retire", &RetireCntYear[0], size},
+                               {"DUE", &DUECntYear[0], size},
+                               {"SDC", &SDCCntYear[0], size},
+#ifdef DUE_BREAKDOWN
+                               {"DUE_Parity", &DUE_ParityYear[0], size},
+                               {"DUE_NoErasure", &DUE_NoErasureYear[0], size},
+                               {"SDC_Erasure", &SDC_ErasureYear[0], size},
+#endif
+                              };
+    list.assign(counters, counters+sizeof(counters)/sizeof(CounterArray));
+}
+
+void TesterSystem::listWeights(std::vector<WeightArray> &list) {
+    int size = getColumnCount()*MAX_YEAR;
+    WeightArray weights[] = {{"RetireWeight", &RetireWeightYear[0], size},
+                             {"RetireWeight2", &RetireWeight2Year[0], size},
+                             {"DUEWeight", &DUEWeightYear[0], size},
+                             {"DUEWeight2", &DUEWeight2Year[0], size},
+                             {"SDCWeight", &SDCWeightYear[0], size},
+                             {"SDCWeight2", &SDCWeight2Year[0], size},
+#ifdef DUE_BREAKDOWN
+                             {"DUE_ParityWeight", &DUE_ParityWeightYear[0], size},
+                             {"DUE_ParityWeight2", &DUE_ParityWeight2Year[0], size},
+                             {"DUE_NoErasureWeight", &DUE_NoErasureWeightYear[0], size},
+                             {"DUE_NoErasureWeight2", &DUE_NoErasureWeight2Year[0], size},
+                             {"SDC_ErasureWeight", &SDC_ErasureWeightYear[0], size},
+                             {"SDC_ErasureWeight2", &SDC_ErasureWeight2Year[0], size},
+#endif
+                             {"weightSum", weightSum, 1},
+                             {"weightSum2", weightSum2, 1},
+                            };
+    list.assign(weights, weights+sizeof(weights)/sizeof(WeightArray));
 }
 
 //------------------------------------------------------------------------------
 void TesterSystem::test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, long runCnt, char* filePrefix, int faultCount, std::string *faults) {
     assert(faultCount<=1);  // either no or 1 inherent fault
 
-    Fault *inherentFault = NULL;
+    this->dg = dg;
+    this->ecc = ecc;
+    this->scrubber = scrubber;
+    this->faultCount = faultCount;
+    this->faults = faults;
+
+    // the sampling of a replayed log is the one it was recorded with
+    FaultLogReader reader;
+    replayLog = NULL;
+    if (!replayName.empty()) {
+        if (!reader.open(replayName.c_str())) {
+            exit(1);
+        }
+        const FaultLogHeader &header = reader.getHeader();
+        FaultDomain *fd = dg->getAnyFD();
+        if ((header.domainCount!=(uint32_t) dg->getDomainCount()) || (header.ranksPerDomain!=fd->ranksPerDomain)
+         || (header.chipCount!=fd->getChipCount()) || (header.chipWidth!=fd->getChipWidth()) || (header.beatHeight!=fd->getBeatHeight())) {
+            printf("%s was recorded on another geometry (or DIMM count)\n", replayName.c_str());
+            exit(1);
+        }
+        if ((unsigned long long) runCnt>header.runCount) {
+            printf("%s holds %llu runs only\n", replayName.c_str(), (unsigned long long) header.runCount);
+            exit(1);
+        }
+        setImportanceSampling(header.rateScale, header.typeBias);
+        replayLog = &reader;
+    }
+
+    inherentFault = NULL;
     // create log file
     std::string nameBuffer = std::string(filePrefix)+".S";
+    if (replayLog!=NULL) {
+        nameBuffer = nameBuffer+".replay-"+replayName.substr(replayName.find_last_of('/')+1);
+    }
     if (faultCount==1) {    // no inherent fault
         nameBuffer = nameBuffer+"."+faults[0];
         inherentFault = Fault::genRandomFault(faults[0], NULL);
         dg->setInherentFault(inherentFault);
     }
-    FILE *fd = fopen(nameBuffer.c_str(), "w");
-    assert(fd!=NULL);
+    for (size_t t=0; t<retireThresholds.size(); t++) {
+        char buffer[32];
+        sprintf(buffer, (t==0) ? ".retire%llu" : "-%llu", retireThresholds[t]);
+        nameBuffer = nameBuffer+buffer;
+    }
+    if (isWeighted()) {
+        char buffer[64];
+        sprintf(buffer, ".is%gx%g", rateScale, typeBias);
+        nameBuffer = nameBuffer+buffer;
+    }
+    dg->setTypeBias(typeBias);
+    setupRates();
+    if (!retireThresholds.empty()) {
+        ecc->setDoRetire(true);
+    }
+
+    // regenerate a single lifetime from its index
+    if (replayRun>=0) {
+        reset();
+        if (replayLog!=NULL) {
+            replayLifetime = replayLog->findLifetime(replayRun);
+            if ((replayLifetime!=NULL) && (replayLifetime->runNum==(uint64_t) replayRun)) {
+                runLifetime(replayRun, true);
+            } else {
+                printf("run %ld has no fault arrival\n", replayRun);
+            }
+            replayLifetime = NULL;
+            replayLog = NULL;
+        } else if (skipEmpty && !isNonEmpty(replayRun)) {
+            printf("run %ld has no fault arrival\n", replayRun);
+        } else {
+            runLifetime(replayRun, skipEmpty);
+        }
+        return;
+    }
+
+    FaultLogWriter writer;
+    recordLog = NULL;
+    if (!recordName.empty()) {
+        FaultLogHeader header;
+        memset(&header, 0, sizeof(header));
+        double horizon = (MAX_YEAR-1)*24*365;
+        FaultDomain *fd = dg->getAnyFD();
+        header.seed = seed;
+        header.rateScale = rateScale;
+        header.typeBias = typeBias;
+        header.emptyLogWeight = (rateScale-1.)*getMeanRate(0., horizon)*horizon;
+        header.domainCount = dg->getDomainCount();
+        header.ranksPerDomain = fd->ranksPerDomain;
+        header.chipCount = fd->getChipCount();
+        header.chipWidth = fd->getChipWidth();
+        header.beatHeight = fd->getBeatHeight();
+        if (!writer.open(recordName.c_str(), header)) {
+            exit(1);
+        }
+        recordLog = &writer;
+    }
 
     // reset statistics
     reset();
 
-    // for runCnt times
-    for (long runNum=0; runNum<runCnt; runNum++) {
-        if ((runNum==100) || ((runNum!=0)&&(runNum%100000000==0))) {
-            printSummary(fd, runNum);
+    run(nameBuffer, runCnt);
+    recordLog = NULL;
+    replayLog = NULL;
+}
+
+//------------------------------------------------------------------------------
+void TesterSystem::runRange(long runBegin, long runEnd) {
+    if (threadCount>1) {
+        printf("Processing %ldth iteration\n", runBegin);
+        testParallel(runBegin, runEnd);
+    } else {
+        long chunkEnd;
+        for (long chunk=runBegin; chunk<runEnd; chunk=chunkEnd) {
+            chunkEnd = (chunk/10000000+1)*10000000;
+            if (chunkEnd>runEnd) {
+                chunkEnd = runEnd;
+            }
+            if (chunk%10000000==0) {
+                printf("Processing %ldth iteration\n", chunk);
+            }
+
+            runLifetimes(chunk, chunkEnd);
         }
-        if (runNum%10000000==0) {
-        //if (runNum%1000000==0) {
-            printf("Processing %ldth iteration\n", runNum);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Most lifetimes have no fault arrival (P = exp(-rate*horizon)) and end with
+// nothing to count. With skipEmpty, only non-empty lifetimes are simulated:
+// within each aligned block of SKIP_BLOCK runs, the gaps between non-empty
+// lifetimes are geometric and drawn from a block-indexed stream (event
+// SKIP_EVENT, never used by a lifetime). The set of non-empty lifetimes thus
+// does not depend on how runs are split across threads, stops or shards, and
+// each of them is simulated from its own run-indexed stream, conditioned on
+// its first arrival being within the horizon.
+static const long SKIP_BLOCK = 1l<<20;
+static const unsigned SKIP_EVENT = 0xFFFFFFFFu;
+
+void TesterSystem::runLifetimes(long runBegin, long runEnd) {
+    if (recordLog!=NULL) {
+        recordLog->coverRuns(runEnd);
+    }
+    // the non-empty lifetimes are those of the log
+    if (replayLog!=NULL) {
+        long simulated = 0;
+        for (replayLifetime=replayLog->findLifetime(runBegin); (replayLifetime!=NULL) && ((long) replayLifetime->runNum<runEnd); replayLifetime=replayLog->nextLifetime(replayLifetime)) {
+            runLifetime(replayLifetime->runNum, true);
+            simulated++;
         }
+        replayLifetime = NULL;
+        addEmptyLifetimes((runEnd-runBegin)-simulated, replayLog->getHeader().emptyLogWeight);
+        return;
+    }
 
-        if (inherentFault!=NULL) {
-            dg->setInitialRetiredBlkCount(ecc);
+    if (!skipEmpty) {
+        for (long runNum=runBegin; runNum<runEnd; runNum++) {
+            runLifetime(runNum, false);
+        }
+        return;
+    }
+
+    double horizon = (MAX_YEAR-1)*24*365;
+    double emptyProb = exp(-getMeanRate(0., horizon)*rateScale*horizon);
+    RandomGenerator skipStream;
+    skipStream.seed(seed);
+
+    long simulated = 0;
+    for (long block=runBegin/SKIP_BLOCK; block*SKIP_BLOCK<runEnd; block++) {
+        skipStream.startRun(block);
+        skipStream.startEvent(SKIP_EVENT);
+        long blockEnd = ((block+1)*SKIP_BLOCK < runEnd) ? (block+1)*SKIP_BLOCK : runEnd;
+        for (long runNum=nextNonEmpty(skipStream, block*SKIP_BLOCK-1, emptyProb); runNum<blockEnd; runNum=nextNonEmpty(skipStream, runNum, emptyProb)) {
+            if (runNum>=runBegin) {
+                runLifetime(runNum, true);
+                simulated++;
+            }
+        }
+    }
+
+    // the weight of an empty lifetime (1 without importance sampling)
+    addEmptyLifetimes((runEnd-runBegin)-simulated, (rateScale-1.)*getMeanRate(0., horizon)*horizon);
+}
+
+void TesterSystem::addEmptyLifetimes(long count, double logWeight) {
+    double emptyWeight = exp(logWeight);
+    weightSum[0] += count*emptyWeight;
+    weightSum2[0] += count*emptyWeight*emptyWeight;
+}
+
+// the next non-empty lifetime after runNum (geometric gap)
+long TesterSystem::nextNonEmpty(RandomGenerator &skipStream, long runNum, double emptyProb) {
+    if (emptyProb>=1.) {
+        return LONG_MAX;
+    }
+    double gap = floor(log(1.0-skipStream.uniformReal()) / log(emptyProb));
+    return (gap < (double) SKIP_BLOCK) ? runNum+1+(long) gap : LONG_MAX;
+}
+
+bool TesterSystem::isNonEmpty(long runNum) {
+    double horizon = (MAX_YEAR-1)*24*365;
+    double emptyProb = exp(-getMeanRate(0., horizon)*rateScale*horizon);
+    RandomGenerator skipStream;
+    skipStream.seed(seed);
+    skipStream.startRun(runNum/SKIP_BLOCK);
+    skipStream.startEvent(SKIP_EVENT);
+    long nonEmpty = nextNonEmpty(skipStream, (runNum/SKIP_BLOCK)*SKIP_BLOCK-1, emptyProb);
+    while (nonEmpty<runNum) {
+        nonEmpty = nextNonEmpty(skipStream, nonEmpty, emptyProb);
+    }
+    return nonEmpty==runNum;
+}
+
+//------------------------------------------------------------------------------
+// simulate a lifetime and accumulate its outcome to the per-year counters
+// - random stream: run = runNum, event k = k-th arrival (its time, then its
+//   fault and decode)
+// - discrete-event loop: arrivals, per-domain scrub completions and the horizon
+// - nonEmpty: the lifetime is known to have an arrival within the horizon
+// - replayLifetime: the arrivals (and weights) are those of the fault log,
+//   decoded from the same draws of their events as when they were recorded
+void TesterSystem::runLifetime(long runNum, bool nonEmpty) {
+    randomGenerator.startRun(runNum);
+
+    if (inherentFault!=NULL) {
+        dg->setInitialRetiredBlkCount(ecc);
+    }
+
+    unsigned eventNum = 0;
+    double horizon = (MAX_YEAR-1)*24*365;
+    // log of the likelihood ratio (true / sampled density) of this lifetime
+    // - per arrival: (1/rateScale) * exp((rateScale-1)*hazard over dt) * type ratio
+    // - after the last arrival: exp((rateScale-1)*hazard over dt) up to the horizon
+    double logWeight = 0.;
+    double prevHr = 0.;     // the last arrival
+    int aliveCount = getColumnCount();
+    columnAlive.assign(aliveCount, 1);
+
+    // the next arrival is drawn as soon as the previous one is processed,
+    // from its own event of the run; it then continues that event's stream
+    events.clear();
+    events.push(horizon, SIM_HORIZON);
+    randomGenerator.startEvent(++eventNum);
+    double nextHr = nextArrival(eventNum, 0., nonEmpty, horizon);
+    if (nextHr <= horizon) {
+        events.push(nextHr, SIM_ARRIVAL);
+    }
+
+    bool done = false;
+    while (!done) {
+        SimEvent event = events.pop();
+        double hr = event.hr;
+
+        if (event.type==SIM_SCRUB) {
+            // scrub soft errors
+            event.fd->scrub();
+            event.fd->scrubPending = false;
+            continue;
+        }
+        if (event.type==SIM_HORIZON) {
+            if (replayLifetime!=NULL) {
+                logWeight = replayLifetime->logWeight;
+            } else {
+                logWeight += (rateScale-1.)*getMeanRate(prevHr, horizon)*(horizon-prevHr);
+            }
+            break;
         }
 
-        double hr = 0.;
+        // fault arrival
+        FaultDomain *fd;
+        ErrorType result;
+        if (replayLifetime!=NULL) {
+            // 1. rebuild the logged fault
+            const FaultLogRecord &record = FaultLogReader::getFaults(replayLifetime)[eventNum-1];
+            fd = dg->getFD(record.domain);
+            logWeight = record.logWeight;
 
-        while (true) {
-            // 1. Advance
-            double prevHr = hr;
-            hr += advance(dg->getFaultRate());
+            // 2. generate an error and decode it
+            randomGenerator.setDrawIndex(record.drawIndex);
+            result = fd->genLoggedFaultAndTest(ecc, dg->getPrototype(record.typeID), record);
+        } else {
+            logWeight += (rateScale-1.)*getMeanRate(prevHr, hr)*(hr-prevHr) - log(rateScale);
 
-            if (hr > (MAX_YEAR-1)*24*365) {
-                break;
+            // 1. generate a fault
+            int domainID = dg->pickRandomDomainID();
+            fd = dg->getFD(domainID);
+            Fault *fault = fd->genSystemRandomFault(hr);
+            logWeight += log(fd->faultRateInfo->getLastRatio());
+            if (recordLog!=NULL) {
+                logFault(domainID, hr, logWeight, fault);
             }
 
-            // 2. scrub soft errors
-            scrubber->scrub(dg, hr);
+            // 2. generate an error and decode it
+            result = fd->testNewFault(ecc, fault);
+        }
+        prevHr = hr;
 
-            // 3. generate a fault
-            FaultDomain *fd = dg->pickRandomFD();
+        if (replayRun>=0) {
+            printf("event %u: %lf hours -> %s\n", eventNum, hr, errorName[result]);
+            fd->print();
+        }
 
-            // 4. generate an error and decode it
-            ErrorType result = fd->genSystemRandomFaultAndTest(ecc);
+        // 3. a soft error stays until the next scrub of its domain
+        if (!fd->scrubPending && fd->hasTransientFault()) {
+            double scrubHr = scrubber->getNextScrubHr(hr);
+            if (scrubHr <= horizon) {
+                events.push(scrubHr, SIM_SCRUB, fd);
+                fd->scrubPending = true;
+            }
+        }
 
-            // 5. process result
-			// default : PF retirement
-            if ((result==CE)&&ecc->getDoRetire()&&(fd->getRetiredBlkCount() > ecc->getMaxRetiredBlkCount())) {
+        // 4. process result
+        // default : PF retirement (per threshold; the lifetime goes on
+        //           while a larger threshold has not retired yet)
+        if ((result==CE)&&ecc->getDoRetire()) {
 //printf("%d %llu %llu\n", ecc->getDoRetire(), fd->getRetiredBlkCount(), ecc->getMaxRetiredBlkCount());
-                for (int i=0; i<MAX_YEAR; i++) {
-                    if (hr < i*24*365) {
-                        RetireCntYear[i]++;
-                    }
+            for (int column=0; column<getColumnCount(); column++) {
+                unsigned long long threshold = retireThresholds.empty() ? ecc->getMaxRetiredBlkCount() : retireThresholds[column];
+                if (columnAlive[column] && (fd->getRetiredBlkCount() > threshold)) {
+                    countOutcome(column, RetireCntYear, RetireWeightYear, RetireWeight2Year, hr, exp(logWeight));
+                    columnAlive[column] = 0;
+                    aliveCount--;
                 }
-                break;
-            } else if (result==DUE) {
-                for (int i=0; i<MAX_YEAR; i++) {
-                    if (hr < i*24*365) {
-                        DUECntYear[i]++;
-                    }
-                }
-                break;
-            } else if (result==SDC) {
-printf("hours %lf (%lfyrs)\n", hr, hr/(24*365));
-                for (int i=0; i<MAX_YEAR; i++) {
-                    if (hr < i*24*365) {
-                        SDCCntYear[i]++;
-                    }
-                }
-                break;
-            } 
+            }
+            done = (aliveCount==0);
+        } else if (result==DUE) {
+            countAlive(DUECntYear, DUEWeightYear, DUEWeight2Year, hr, exp(logWeight));
+            done = true;
+        } else if (result==SDC) {
+            if (replayRun>=0) {
+                printf("run %ld hours %lf (%lfyrs)\n", runNum, hr, hr/(24*365));
+            }
+            countAlive(SDCCntYear, SDCWeightYear, SDCWeight2Year, hr, exp(logWeight));
+            done = true;
+        } 
 #ifdef DUE_BREAKDOWN			
-			else if (result==DUE_Parity) {
-                for (int i=0; i<MAX_YEAR; i++) {
-                    if (hr < i*24*365) {
-                        DUE_ParityYear[i]++;
-                        DUECntYear[i]++;
-                    }
-                }
-                break;
-            } else if (result==DUE_NoErasure) {
-                for (int i=0; i<MAX_YEAR; i++) {
-                    if (hr < i*24*365) {
-                        DUE_NoErasureYear[i]++;
-                        DUECntYear[i]++;
-                    }
-                }
-                break;
-            } else if (result==SDC_Erasure) {
-printf("== hours %lf (%lfyrs)\n", hr, hr/(24*365));
-                for (int i=0; i<MAX_YEAR; i++) {
-                    if (hr < i*24*365) {
-                        SDC_ErasureYear[i]++;
-                        SDCCntYear[i]++;
-                    }
-                }
-                break;
+        else if (result==DUE_Parity) {
+            countAlive(DUE_ParityYear, DUE_ParityWeightYear, DUE_ParityWeight2Year, hr, exp(logWeight));
+            countAlive(DUECntYear, DUEWeightYear, DUEWeight2Year, hr, exp(logWeight));
+            done = true;
+        } else if (result==DUE_NoErasure) {
+            countAlive(DUE_NoErasureYear, DUE_NoErasureWeightYear, DUE_NoErasureWeight2Year, hr, exp(logWeight));
+            countAlive(DUECntYear, DUEWeightYear, DUEWeight2Year, hr, exp(logWeight));
+            done = true;
+        } else if (result==SDC_Erasure) {
+            if (replayRun>=0) {
+                printf("== run %ld hours %lf (%lfyrs)\n", runNum, hr, hr/(24*365));
             }
+            countAlive(SDC_ErasureYear, SDC_ErasureWeightYear, SDC_ErasureWeight2Year, hr, exp(logWeight));
+            countAlive(SDCCntYear, SDCWeightYear, SDCWeight2Year, hr, exp(logWeight));
+            done = true;
+        }
 #endif
+
+        // 5. the next arrival
+        if (!done) {
+            randomGenerator.startEvent(++eventNum);
+            nextHr = nextArrival(eventNum, hr, false, horizon);
+            if (nextHr <= horizon) {
+                events.push(nextHr, SIM_ARRIVAL);
+            }
         }
+    }
 
-        dg->clear();
-        ecc->clear();
+    // the timeline goes on to the horizon in the log
+    if ((recordLog!=NULL) && !recordLog->faults.empty()) {
+        recordLog->writeLifetime(runNum, done ? logTail(eventNum, prevHr, logWeight, horizon) : logWeight);
     }
-    printSummary(fd, runCnt);
 
-    fclose(fd);
+    double weight = exp(logWeight);
+    weightSum[0] += weight;
+    weightSum2[0] += weight*weight;
+    if ((replayRun>=0) && isWeighted()) {
+        printf("likelihood-ratio weight %g\n", weight);
+    }
+
+    dg->clear();
+    ecc->clear();
+}
+
+// the time of arrival eventNum (after hr): logged, or drawn from its event
+double TesterSystem::nextArrival(unsigned eventNum, double hr, bool within, double horizon) {
+    if (replayLifetime!=NULL) {
+        return (eventNum<=replayLifetime->faultCount) ? FaultLogReader::getFaults(replayLifetime)[eventNum-1].hr : INFINITY;
+    }
+    return within ? advanceWithin(horizon) : advance(hr);
+}
+
+// the new fault of the current event, before its decode
+void TesterSystem::logFault(int domainID, double hr, double logWeight, Fault *fault) {
+    FaultLogRecord record;
+    memset(&record, 0, sizeof(record));
+    record.hr = hr;
+    record.logWeight = logWeight;
+    record.domain = domainID;
+    record.drawIndex = randomGenerator.getDrawIndex();
+    fault->saveParams(&record);
+    recordLog->faults.push_back(record);
+}
+
+// log the arrivals after the outcome of a lifetime (arrival eventNum at hr),
+// as they would have been drawn had it gone on; the log weight at the horizon
+double TesterSystem::logTail(unsigned eventNum, double hr, double logWeight, double horizon) {
+    while (true) {
+        randomGenerator.startEvent(++eventNum);
+        double nextHr = advance(hr);
+        if (nextHr > horizon) {
+            break;
+        }
+        logWeight += (rateScale-1.)*getMeanRate(hr, nextHr)*(nextHr-hr) - log(rateScale);
+        hr = nextHr;
+
+        int domainID = dg->pickRandomDomainID();
+        FaultDomain *fd = dg->getFD(domainID);
+        Fault *fault = fd->genSystemRandomFault(hr);
+        logWeight += log(fd->faultRateInfo->getLastRatio());
+        logFault(domainID, hr, logWeight, fault);
+        fd->releaseFault(fault);
+    }
+    return logWeight + (rateScale-1.)*getMeanRate(hr, horizon)*(horizon-hr);
+}
+
+// count an outcome at hr (of a lifetime with weight w) to the years after hr
+void TesterSystem::countOutcome(int column, std::vector<long> &cnt, std::vector<double> &weight, std::vector<double> &weight2, double hr, double w) {
+    for (int i=0; i<MAX_YEAR; i++) {
+        if (hr < i*24*365) {
+            cnt[column*MAX_YEAR+i]++;
+            weight[column*MAX_YEAR+i] += w;
+            weight2[column*MAX_YEAR+i] += w*w;
+        }
+    }
+}
+
+// count an outcome for every column still without one
+void TesterSystem::countAlive(std::vector<long> &cnt, std::vector<double> &weight, std::vector<double> &weight2, double hr, double w) {
+    for (int column=0; column<getColumnCount(); column++) {
+        if (columnAlive[column]) {
+            countOutcome(column, cnt, weight, weight2, hr, w);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// worker t is a copy of this tester that simulates a fixed slice of the
+// lifetimes with a private DomainGroup/ECC/Scrubber. As every lifetime draws
+// from its own run-indexed stream, the reduced counters do not depend on the
+// thread count.
+void TesterSystem::testParallel(long runBegin, long runEnd) {
+    assert(builder!=NULL);
+
+    std::vector<TesterSystem> workerTesters(threadCount, *this);
+    std::vector<std::thread> workers;
+    for (int t=0; t<threadCount; t++) {
+        long sliceBegin = runBegin + (runEnd-runBegin)*t/threadCount;
+        long sliceEnd = runBegin + (runEnd-runBegin)*(t+1)/threadCount;
+        workers.push_back(std::thread(&TesterSystem::runWorker, &workerTesters[t], sliceBegin, sliceEnd));
+    }
+    for (int t=0; t<threadCount; t++) {
+        workers[t].join();
+        mergeCounters(&workerTesters[t]);
+    }
+}
+
+void TesterSystem::runWorker(long runBegin, long runEnd) {
+    builder(eccID, &dg, &ecc);
+    scrubber = scrubber->clone();
+    randomGenerator.seed(seed);
+
+    inherentFault = NULL;
+    if (faultCount==1) {
+        inherentFault = Fault::genRandomFault(faults[0], NULL);
+        dg->setInherentFault(inherentFault);
+    }
+    dg->setTypeBias(typeBias);
+    setupRates();
+    if (!retireThresholds.empty()) {
+        ecc->setDoRetire(true);
+    }
+
+    reset();
+    runLifetimes(runBegin, runEnd);
+
+    delete inherentFault;
+    delete scrubber;
+    delete ecc;
+    delete dg;
 }
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 void TesterScenario::reset() {
-    for (int i=0; i<=SDC; i++) {
-        errorCnt[i] = 0l;
-    }
+    resetCounters();
 }
+
 //------------------------------------------------------------------------------
 void TesterScenario::printSummary(FILE *fd, long runNum) {
-    fprintf(fd, "After %ld runs\n", runNum);
-    for (int i=0; i<=SDC; i++) {
-        fprintf(fd, "%s\t%.10f\n", errorName[i], (double)errorCnt[i]/runNum);
+    double lower, upper;
+    fprintf(fd, "After %ld runs (%g%% confidence intervals)\n", runNum, confidence*100);
+    if (schemeIDs.size()==1) {
+        for (int i=0; i<=SDC; i++) {
+            getInterval(errorCnt[i], runNum, &lower, &upper);
+            fprintf(fd, "%s\t%.10f\t[%.10f, %.10f]\n", errorName[i], (double)errorCnt[i]/runNum, lower, upper);
+        }
+    } else {
+        // side by side
+        fprintf(fd, "   ");
+        for (size_t k=0; k<schemeIDs.size(); k++) {
+            fprintf(fd, "\t%-40s", schemeNames[k].c_str());
+        }
+        fprintf(fd, "\n");
+        for (int i=0; i<=SDC; i++) {
+            fprintf(fd, "%s", errorName[i]);
+            for (size_t k=0; k<schemeIDs.size(); k++) {
+                long cnt = errorCnt[k*(SDC+1)+i];
+                getInterval(cnt, runNum, &lower, &upper);
+                fprintf(fd, "\t%.10f [%.10f, %.10f]", (double)cnt/runNum, lower, upper);
+            }
+            fprintf(fd, "\n");
+        }
     }
     fflush(fd);
 }
+//------------------------------------------------------------------------------
+void TesterScenario::listCounters(std::vector<CounterArray> &list) {
+    CounterArray counters[] = {{"errorCnt", &errorCnt[0], (int) errorCnt.size()}};
+    list.assign(counters, counters+sizeof(counters)/sizeof(CounterArray));
+}
+
+void TesterScenario::listMetrics(std::vector<Metric> &list) {
+    static const char *metricName[] = {"NE", "CE", "DUE",
+#ifdef DUE_BREAKDOWN
+                                       "DUE_Parity", "DUE_NoErasure",
+#endif
+                                       "SDC"};
+    list.clear();
+    for (size_t k=0; k<schemeIDs.size(); k++) {
+        for (int i=0; i<=SDC; i++) {
+            long cnt = errorCnt[k*(SDC+1)+i];
+            Metric metric = {metricName[i], cnt, (double) cnt, (double) cnt};
+            list.push_back(metric);
+        }
+    }
+}
+
+// schemes <count> <name> ...
+std::string TesterScenario::getConfig() {
+    char buffer[32];
+    sprintf(buffer, "schemes %d", (int) schemeIDs.size());
+    std::string config = buffer;
+    for (size_t k=0; k<schemeNames.size(); k++) {
+        config = config+" "+schemeNames[k];
+    }
+    return config;
+}
+
+bool TesterScenario::setConfig(const std::string &config) {
+    int schemeCount, pos;
+    if ((sscanf(config.c_str(), "schemes %d%n", &schemeCount, &pos)!=1) || (schemeCount<1)) {
+        return false;
+    }
+    const char *str = config.c_str()+pos;
+    char name[1024];
+    for (int k=0; k<schemeCount; k++) {
+        int len;
+        if (sscanf(str, " %1023s%n", name, &len)!=1) {
+            return false;
+        }
+        str += len;
+        if (k==0) {
+            schemeNames[0] = name;
+        } else {
+            addScheme(0, NULL, name);
+        }
+    }
+    return true;
+}
+
 //------------------------------------------------------------------------------
 void TesterScenario::test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, long runCnt, char* filePrefix, int faultCount, std::string *faults) {
     assert(faultCount!=0);
+
+    this->dg = dg;
+    this->ecc = ecc;
+    this->scrubber = scrubber;
+    this->faultCount = faultCount;
+    this->faults = faults;
+    plan = ScenarioPlan(faultCount, faults);
+    schemeIDs[0] = eccID;
+    schemeECCs[0] = ecc;
+    schemeNames[0] = filePrefix;
+
     // create log file
-    std::string nameBuffer = std::string(filePrefix)+"."+faults[0];
-    for (int i=1; i<faultCount; i++) {
+    std::string nameBuffer = std::string(filePrefix);
+    for (size_t k=1; k<schemeIDs.size(); k++) {
+        char buffer[32];
+        sprintf(buffer, "+%03d", schemeIDs[k]);
+        nameBuffer = nameBuffer+buffer;
+    }
+    for (int i=0; i<faultCount; i++) {
         nameBuffer = nameBuffer+"."+faults[i];
     }
-    FILE *fd = fopen(nameBuffer.c_str(), "w");
-    assert(fd!=NULL);
+
+    // regenerate a single iteration from its index
+    if (replayRun>=0) {
+        randomGenerator.startRun(replayRun);
+        dg->getFD()->genScenarioRandomFaultAndTest(schemeECCs.size(), &schemeECCs[0], plan, &schemeResults[0]);
+        for (size_t k=0; k<schemeIDs.size(); k++) {
+            printf("run %ld -> %s (%s)\n", replayRun, errorName[schemeResults[k]], schemeNames[k].c_str());
+        }
+        dg->getFD()->print();
+        return;
+    }
 
     // reset statistics
     reset();
 
-    // for runCnt times
-    for (long runNum=0; runNum<runCnt; runNum++) {
-        if ((runNum==100) || ((runNum!=0)&&(runNum%100000000==0))) {
-            printSummary(fd, runNum);
-        }
-        if (runNum%10000000==0) {
-            printf("Processing %ldth iteration\n", runNum);
+    run(nameBuffer, runCnt);
+}
+
+//------------------------------------------------------------------------------
+void TesterScenario::runRange(long runBegin, long runEnd) {
+    if (threadCount>1) {
+        printf("Processing %ldth iteration\n", runBegin);
+        testParallel(runBegin, runEnd);
+    } else {
+        for (long runNum=runBegin; runNum<runEnd; runNum++) {
+            if (runNum%10000000==0) {
+                printf("Processing %ldth iteration\n", runNum);
+            }
+
+            runIteration(runNum);
         }
+    }
+}
+
+// generate the faults of an iteration once and decode them with every scheme
+void TesterScenario::runIteration(long runNum) {
+    randomGenerator.startRun(runNum);
+    dg->getFD()->genScenarioRandomFaultAndTest(schemeECCs.size(), &schemeECCs[0], plan, &schemeResults[0]);
+
+    for (size_t k=0; k<schemeResults.size(); k++) {
+        errorCnt[k*(SDC+1)+schemeResults[k]]++;
+    }
+}
+
+//------------------------------------------------------------------------------
+// worker t is a copy of this tester that runs a fixed slice of the iterations
+// with a private DomainGroup/ECC. Every iteration draws from its own
+// run-indexed stream, so the merged counts do not depend on the thread count.
+void TesterScenario::testParallel(long runBegin, long runEnd) {
+    assert(builder!=NULL);
+
+    std::vector<TesterScenario> workerTesters(threadCount, *this);
+    std::vector<std::thread> workers;
+    for (int t=0; t<threadCount; t++) {
+        long sliceBegin = runBegin + (runEnd-runBegin)*t/threadCount;
+        long sliceEnd = runBegin + (runEnd-runBegin)*(t+1)/threadCount;
+        workers.push_back(std::thread(&TesterScenario::runWorker, &workerTesters[t], sliceBegin, sliceEnd));
+    }
+    for (int t=0; t<threadCount; t++) {
+        workers[t].join();
+        mergeCounters(&workerTesters[t]);
+    }
+}
+
+void TesterScenario::runWorker(long runBegin, long runEnd) {
+    builder(eccID, &dg, &ecc);
+    schemeECCs[0] = ecc;
+    for (size_t k=1; k<schemeIDs.size(); k++) {
+        DomainGroup *schemeDG;
+        builder(schemeIDs[k], &schemeDG, &schemeECCs[k]);
+        delete schemeDG;
+    }
+    randomGenerator.seed(seed);
 
-        ErrorType result = dg->getFD()->genScenarioRandomFaultAndTest(ecc, faultCount, faults);
+    reset();
+    for (long runNum=runBegin; runNum<runEnd; runNum++) {
+        runIteration(runNum);
+    }
 
-        errorCnt[result]++;
+    for (size_t k=1; k<schemeIDs.size(); k++) {
+        delete schemeECCs[k];
     }
-    
-	printSummary(fd, runCnt);
-	
-	fclose(fd);
+    delete ecc;
+    delete dg;
 }
 
 
 //------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+void TesterTrace::test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, long runCnt, char* filePrefix, int faultCount, std::string *faults) {
+    assert(faultCount==1);  // the trace
+
+    this->dg = dg;
+    this->ecc = ecc;
+    this->scrubber = scrubber;
+    this->faultCount = faultCount;
+    this->faults = faults;
+
+    if (!trace.open(faults[0].c_str())) {
+        exit(1);
+    }
+    long eventCnt = trace.getRecordCount();
+    if ((runCnt>0) && (runCnt<eventCnt)) {
+        eventCnt = runCnt;
+    }
+    yearCount = (eventCnt==0) ? 1 : (int) (trace.getRecord(eventCnt-1).hr/(24*365))+1;
+
+    // create log file
+    size_t slash = faults[0].rfind('/');
+    std::string nameBuffer = std::string(filePrefix)+".T."+faults[0].substr((slash==std::string::npos) ? 0 : slash+1);
+
+    reset();
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    runRange(0, eventCnt);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec-start.tv_sec) + (end.tv_nsec-start.tv_nsec)*1e-9;
+    printf("%ld events in %.2fs (%.0f events/s)\n", eventCnt, seconds, (seconds>0.) ? eventCnt/seconds : 0.);
+
+    if (replayRun<0) {
+        FILE *fd = fopen(nameBuffer.c_str(), "w");
+        assert(fd!=NULL);
+        printSummary(fd, eventCnt);
+        fclose(fd);
+    }
+
+    dg->clear();
+    ecc->clear();
+    trace.close();
+}
+
+void TesterTrace::reset() {
+    resultCntYear.assign(yearCount*(SDC+1), 0l);
+    repeatCntYear.assign(yearCount, 0l);
+    RetireCntYear.assign(yearCount, 0l);
+}
+
+//------------------------------------------------------------------------------
+void TesterTrace::runRange(long runBegin, long runEnd) {
+    if (runBegin>=runEnd) {
+        return;
+    }
+    events.clear();
+    long eventNum = runBegin;
+    events.push(trace.getRecord(eventNum).hr, SIM_ARRIVAL);
+    while (!events.empty()) {
+        SimEvent event = events.pop();
+        double hr = event.hr;
+
+        if (event.type==SIM_SCRUB) {
+            // scrub soft errors
+            event.fd->scrub();
+            event.fd->scrubPending = false;
+            continue;
+        }
+
+        // 1. the fault of the event on its domain
+        const TraceRecord &record = trace.getRecord(eventNum);
+        if (record.domain>=(uint32_t) dg->getDomainCount()) {
+            printf("Event %ld is on domain %u, outside the %d domains of the group (see --dimms)\n", eventNum, record.domain, dg->getDomainCount());
+            exit(1);
+        }
+        FaultDomain *fd = dg->getFD(record.domain);
+        if (((record.rank!=TRACE_ANY8) && (record.rank>=fd->ranksPerDomain))
+         || ((record.chip!=TRACE_ANY8) && (record.chip>=fd->getChipCount()))
+         || ((record.dq!=TRACE_ANY8) && (record.dq>=fd->getChipWidth()))
+         || ((record.beat!=TRACE_ANY8) && (record.beat>=fd->getBeatHeight()))) {
+            printf("Event %ld (rank %u, chip %u, dq %u, beat %u) is outside its domain (%d ranks, %d chips of %d DQs, %d beats)\n",
+                   eventNum, record.rank, record.chip, record.dq, record.beat,
+                   fd->ranksPerDomain, fd->getChipCount(), fd->getChipWidth(), fd->getBeatHeight());
+            exit(1);
+        }
+        randomGenerator.startRun(eventNum);
+
+        // 2. generate its error and decode it with the faults it overlaps
+        bool isRepeat;
+        ErrorType result = fd->genTraceFaultAndTest(ecc, record, &isRepeat);
+        int year = (int) (hr/(24*365));
+        if (year>=yearCount) {
+            year = yearCount-1;
+        }
+        if (isRepeat) {
+            repeatCntYear[year]++;
+        } else {
+            resultCntYear[year*(SDC+1)+result]++;
+        }
+
+        if (eventNum==replayRun) {
+            printf("event %ld: %lf hours, domain %u -> %s%s\n", eventNum, hr, record.domain, errorName[result], isRepeat ? " (repeat)" : "");
+            fd->print();
+        }
+
+        // 3. a soft error stays until the next scrub of its domain
+        if (!fd->scrubPending && fd->hasTransientFault()) {
+            double scrubHr = scrubber->getNextScrubHr(hr);
+            if (scrubHr!=INFINITY) {
+                events.push(scrubHr, SIM_SCRUB, fd);
+                fd->scrubPending = true;
+            }
+        }
+
+        // 4. replace the DIMMs of a domain that retired too much or failed
+        if ((result==CE) && ecc->getDoRetire() && (fd->getRetiredBlkCount() > ecc->getMaxRetiredBlkCount())) {
+            RetireCntYear[year]++;
+            fd->clear();
+        } else if ((result!=NE) && (result!=CE)) {
+            fd->clear();
+        }
+
+        // 5. the next event
+        if (++eventNum<runEnd) {
+            events.push(trace.getRecord(eventNum).hr, SIM_ARRIVAL);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void TesterTrace::printSummary(FILE *fd, long runNum) {
+    fprintf(fd, "After %ld events of %s\n", runNum, faults[0].c_str());
+    fprintf(fd, "year\trepeat");
+    for (int i=0; i<=SDC; i++) {
+        fprintf(fd, "\t%s", errorName[i]);
+    }
+    fprintf(fd, "\tRetire\n");
+    for (int year=0; year<yearCount; year++) {
+        fprintf(fd, "%d\t%ld", year, repeatCntYear[year]);
+        for (int i=0; i<=SDC; i++) {
+            fprintf(fd, "\t%ld", resultCntYear[year*(SDC+1)+i]);
+        }
+        fprintf(fd, "\t%ld\n", RetireCntYear[year]);
+    }
+    fflush(fd);
+}
+
+void TesterTrace::listCounters(std::vector<CounterArray> &list) {
+    CounterArray counters[] = {{"resultCnt", &resultCntYear[0], (int) resultCntYear.size()},
+                               {"repeatCnt", &repeatCntYear[0], yearCount},
+                               {"RetireCnt", &RetireCntYear[0], yearCount}};
+    list.assign(counters, counters+sizeof(counters)/sizeof(CounterArray));
+}
+
+// DUE/SDC decodes over the whole trace
+void TesterTrace::listMetrics(std::vector<Metric> &list) {
+    long dueCnt = 0, sdcCnt = 0;
+    for (int year=0; year<yearCount; year++) {
+        dueCnt += resultCntYear[year*(SDC+1)+DUE];
+        sdcCnt += resultCntYear[year*(SDC+1)+SDC];
+    }
+    Metric metrics[] = {{"DUE", dueCnt, (double) dueCnt, (double) dueCnt},
+                        {"SDC", sdcCnt, (double) sdcCnt, (double) sdcCnt}};
+    list.assign(metrics, metrics+sizeof(metrics)/sizeof(Metric));
+}
@@ -3,6 +3,8 @@
 
 #include <stdio.h>
 #include <list>
+#include <string>
+#include <vector>
 
 #include "common.hh"
 #include "codec.hh"
@@ -11,6 +13,10 @@
 #include "VECC.hh"
 #include "FECC.hh"
 #include "AIECC.hh"
+#include "EventQueue.hh"
+#include "RateProfile.hh"
+#include "Trace.hh"
+#include "FaultLog.hh"
 
 #define MAX_YEAR    6
 
@@ -18,46 +24,292 @@ class FaultDomain;
 class DomainGroup;
 class Scrubber;
 
+// builds a private DomainGroup/ECC pair of an ECC ID for a worker thread
+typedef void (*SetupBuilder)(int eccID, DomainGroup **dg, ECC **ecc);
+
+// a named counter array of a tester
+// (for merging workers and shards, checkpoints and partial results)
+struct CounterArray {
+    const char *name;
+    long *data;
+    int size;
+};
+
+struct WeightArray {
+    const char *name;
+    double *data;
+    int size;
+};
+
+// a binomial outcome of a tester
+// - # of runs with it, and the sum of their weights (and squared weights)
+struct Metric {
+    const char *name;
+    long count;
+    double weight;
+    double weight2;
+};
+
 class Tester {
 public:
-    Tester() {}
+    Tester() : seed(0), threadCount(1), builder(NULL), eccID(0), replayRun(-1), checkpointInterval(0), resume(false), shardID(0), shardCount(1), firstRun(0), relCI(0.), confidence(0.95), zScore(1.959963984540054) {}
+    virtual ~Tester() {}
 
     virtual void test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, long runCnt, char *filePrefix, int faultCount, std::string *faults) = 0;
+
+    void setSeed(unsigned long long _seed) { seed = _seed; }
+    // split runs across worker threads
+    // - each worker builds its own DomainGroup/ECC
+    void setParallel(int _threadCount, SetupBuilder _builder, int _eccID) {
+        threadCount = _threadCount;
+        builder = _builder;
+        eccID = _eccID;
+    }
+    // regenerate only the given run (from its index) and print its faults
+    void setReplayRun(long runNum) { replayRun = runNum; }
+    // save a checkpoint every interval runs (0: never), and/or resume from it
+    void setCheckpoint(long interval, bool _resume) { checkpointInterval = interval; resume = _resume; }
+    // simulate only shard k (out of K) of the runs [firstRun, runCnt)
+    // and write its partial result for mergeShards()
+    void setShard(int _shardID, int _shardCount, long _firstRun) { shardID = _shardID; shardCount = _shardCount; firstRun = _firstRun; }
+    // stop (before runCnt) once the Wilson interval of every metric is
+    // within +-relCI of its estimate (0: always run runCnt runs)
+    void setPrecision(double _relCI, double _confidence, const std::string &metrics);
+
+    // merge partial results into the summary a single run would produce
+    static void mergeShards(int partCount, char **partNames);
+protected:
+    void run(const std::string &logName, long runCnt);
+    long runStops(FILE *fd, const std::string &checkpointName, long runBegin, long runNum, long runEnd);
+    long nextStop(long runBegin, long runNum, long runEnd);
+    bool loadCheckpoint(const std::string &name, long runBegin, long runEnd, long *runNum);
+    void saveCheckpoint(const std::string &name, long runNum);
+    void savePartial(const std::string &name, const std::string &logName, long runBegin, long runEnd);
+
+    void resetCounters();
+    void mergeCounters(Tester *other);
+    void writeCounters(FILE *fd);
+    bool readCounters(FILE *fd);
+
+    void getInterval(long count, long runNum, double *lower, double *upper);
+    void getWeightedInterval(double weight, double weight2, long runNum, double *lower, double *upper);
+    bool isPrecise(long runNum);
+
+    virtual const char *getType() = 0;
+    // runs are weighted by their likelihood ratios (importance sampling)
+    virtual bool isWeighted() { return false; }
+    // configuration that changes the meaning of the counters (in partial results)
+    virtual std::string getConfig() = 0;
+    virtual bool setConfig(const std::string &config) = 0;
+    virtual void listCounters(std::vector<CounterArray> &list) = 0;
+    virtual void listWeights(std::vector<WeightArray> &) {}
+    virtual void listMetrics(std::vector<Metric> &list) = 0;
+    virtual void runRange(long runBegin, long runEnd) = 0;
+    virtual void printSummary(FILE *fd, long runNum) = 0;
+protected:
+    unsigned long long seed;
+    int threadCount;
+    SetupBuilder builder;
+    int eccID;
+    long replayRun;
+    long checkpointInterval;    // runs between checkpoints (0: none)
+    bool resume;
+    int shardID;
+    int shardCount;
+    long firstRun;
+    double relCI;
+    double confidence;
+    double zScore;
+    std::vector<std::string> ciMetrics;
+
+    // context of the current test()
+    DomainGroup *dg;
+    ECC *ecc;
+    Scrubber *scrubber;
+    int faultCount;
+    std::string *faults;
 };
 
 class TesterSystem : public Tester {
 public:
-    TesterSystem() {}
+    TesterSystem() : rateScale(1.), typeBias(1.), skipEmpty(true), recordLog(NULL), replayLog(NULL), replayLifetime(NULL) { resizeCounters(); }
 
     void test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, long runCnt, char *filePrefix, int faultCount, std::string *faults);
+    // importance sampling: sample fault arrivals at rateScale times the fault
+    // rate and multi-DQ fault types typeBias times more often, and weight
+    // each lifetime by its likelihood ratio (1, 1: plain sampling)
+    void setImportanceSampling(double _rateScale, double _typeBias) { rateScale = _rateScale; typeBias = _typeBias; }
+    // skip lifetimes without any fault arrival analytically (default),
+    // or simulate every lifetime from its own random stream
+    void setSkipEmpty(bool _skipEmpty) { skipEmpty = _skipEmpty; }
+    // evaluate several page-retirement thresholds (maxRetiredBlkCount) on the
+    // same fault timelines: a lifetime runs until every threshold has its
+    // outcome, and each threshold gets its own column of counters
+    void setRetireSweep(const std::vector<unsigned long long> &thresholds) { retireThresholds = thresholds; resizeCounters(); }
+    // time-varying rates: profile of the fault types whose name starts with
+    // prefix (in order; a later profile overrides an earlier one)
+    void addRateProfile(const std::string &prefix, const RateProfile *profile) { rateProfiles.push_back(std::make_pair(prefix, profile)); }
+    // write the fault timeline of every lifetime (up to the horizon) to a
+    // fault log, or decode the timelines of a fault log instead of generating
+    // them (its sampling and run count; the ECC must be of the same geometry)
+    void setRecordLog(const std::string &name) { recordName = name; }
+    void setReplayLog(const std::string &name) { replayName = name; }
 protected:
     void reset();
+    void resizeCounters();
+    int getColumnCount() { return retireThresholds.empty() ? 1 : (int) retireThresholds.size(); }
+    const char *getType() { return "system"; }
+    bool isWeighted() { return (rateScale!=1.) || (typeBias!=1.); }
+    std::string getConfig();
+    bool setConfig(const std::string &config);
+    void listCounters(std::vector<CounterArray> &list);
+    void listWeights(std::vector<WeightArray> &list);
+    void listMetrics(std::vector<Metric> &list);
+    void countOutcome(int column, std::vector<long> &cnt, std::vector<double> &weight, std::vector<double> &weight2, double hr, double w);
+    void countAlive(std::vector<long> &cnt, std::vector<double> &weight, std::vector<double> &weight2, double hr, double w);
+    void printOutcome(FILE *fd, const char *name, std::vector<long> &cnt, std::vector<double> &weight, std::vector<double> &weight2, long runNum);
     void printSummary(FILE *fd, long runNum);
-    double advance(double faultRate);
+    void setupRates();
+    double getHazard(double hr);
+    double getMeanRate(double from, double to);
+    double invertHazard(double hazard);
+    double advance(double hr);
+    double advanceWithin(double limit);
+    double nextArrival(unsigned eventNum, double hr, bool within, double horizon);
+    void logFault(int domainID, double hr, double logWeight, Fault *fault);
+    double logTail(unsigned eventNum, double hr, double logWeight, double horizon);
+    void addEmptyLifetimes(long count, double logWeight);
+    void runRange(long runBegin, long runEnd);
+    void runLifetimes(long runBegin, long runEnd);
+    long nextNonEmpty(RandomGenerator &skipStream, long runNum, double emptyProb);
+    bool isNonEmpty(long runNum);
+    void runLifetime(long runNum, bool nonEmpty);
+    void testParallel(long runBegin, long runEnd);
+    void runWorker(long runBegin, long runEnd);
 
 protected:
+    Fault *inherentFault;
+    double rateScale;
+    double typeBias;
+    bool skipEmpty;
+    std::vector<unsigned long long> retireThresholds;
+    std::vector<std::pair<std::string, const RateProfile *>> rateProfiles;
+    double faultRate;                   // nominal group fault rate
+    std::vector<double> hazardTable;    // per HAZARD_CELL hours (empty: constant rates)
+    std::string recordName;
+    std::string replayName;
+    FaultLogWriter *recordLog;      // (NULL: none; single thread only)
+    const FaultLogReader *replayLog;
+    const FaultLogLifetime *replayLifetime; // current lifetime of replayLog
+    std::vector<char> columnAlive;  // columns without an outcome yet (current lifetime)
+    EventQueue events;              // pending events (current lifetime)
+
+    // counters: [column*MAX_YEAR+year], a column per retirement threshold
     // CE + DUE + SDC can be bigger than expected error count
-    long RetireCntYear[MAX_YEAR] = {0};
-    long DUECntYear[MAX_YEAR] = {0};
-    long SDCCntYear[MAX_YEAR] = {0};
+    std::vector<long> RetireCntYear;
+    std::vector<long> DUECntYear;
+    std::vector<long> SDCCntYear;
 #ifdef DUE_BREAKDOWN
-    long DUE_ParityYear[MAX_YEAR] = {0};
-    long DUE_NoErasureYear[MAX_YEAR] = {0};
-    long SDC_ErasureYear[MAX_YEAR] = {0};
+    std::vector<long> DUE_ParityYear;
+    std::vector<long> DUE_NoErasureYear;
+    std::vector<long> SDC_ErasureYear;
 #endif
+
+    // sum of the likelihood-ratio weights (and squared weights) of the
+    // lifetimes counted above (= the counts without importance sampling)
+    std::vector<double> RetireWeightYear;
+    std::vector<double> RetireWeight2Year;
+    std::vector<double> DUEWeightYear;
+    std::vector<double> DUEWeight2Year;
+    std::vector<double> SDCWeightYear;
+    std::vector<double> SDCWeight2Year;
+#ifdef DUE_BREAKDOWN
+    std::vector<double> DUE_ParityWeightYear;
+    std::vector<double> DUE_ParityWeight2Year;
+    std::vector<double> DUE_NoErasureWeightYear;
+    std::vector<double> DUE_NoErasureWeight2Year;
+    std::vector<double> SDC_ErasureWeightYear;
+    std::vector<double> SDC_ErasureWeight2Year;
+#endif
+    // sum of the weights (and squared weights) of all lifetimes
+    double weightSum[1] = {0};
+    double weightSum2[1] = {0};
 };
 
 class TesterScenario : public Tester {
 public:
-    TesterScenario() {}
+    TesterScenario() : schemeIDs(1, 0), schemeECCs(1, (ECC *) NULL), schemeNames(1, ""), schemeResults(1, NE), errorCnt(SDC+1, 0l) {}
+
+    void test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, long runCnt, char *filePrefix, int faultCount, std::string *faults);
+    // decode every iteration with another ECC of the same geometry as well
+    // (common random numbers; counters are reported side by side)
+    void addScheme(int eccID, ECC *ecc, const std::string &name) {
+        schemeIDs.push_back(eccID);
+        schemeECCs.push_back(ecc);
+        schemeNames.push_back(name);
+        schemeResults.push_back(NE);
+        errorCnt.resize(schemeIDs.size()*(SDC+1), 0l);
+    }
+protected:
+    void reset();
+    const char *getType() { return "scenario"; }
+    std::string getConfig();
+    bool setConfig(const std::string &config);
+    void listCounters(std::vector<CounterArray> &list);
+    void listMetrics(std::vector<Metric> &list);
+    void printSummary(FILE *fd, long runNum);
+    void runRange(long runBegin, long runEnd);
+    void runIteration(long runNum);
+    void testParallel(long runBegin, long runEnd);
+    void runWorker(long runBegin, long runEnd);
+
+protected:
+    // schemes: [0] the ECC of test(), [1...] addScheme()
+    std::vector<int> schemeIDs;
+    std::vector<ECC *> schemeECCs;
+    std::vector<std::string> schemeNames;
+    std::vector<ErrorType> schemeResults;
+
+    // faults of test(), compiled once
+    ScenarioPlan plan;
+
+    // errorCnt[scheme*(SDC+1)+result]
+    std::vector<long> errorCnt;
+};
+
+//------------------------------------------------------------------------------
+// Replay of a field error trace (faults[0]: the trace file) through the ECC
+// - every event becomes a fault with its footprint on its domain, and
+//   is decoded with the faults already there, with scrubbing and retirement
+// - a domain with a DUE/SDC, or retiring beyond the ECC limit, has its DIMMs replaced
+// - a report of a fault the domain holds already is counted as a repeat
+// - event i decodes from random stream i (--replay-run i prints it)
+// - runCnt: the number of events to replay (0: all)
+class TesterTrace : public Tester {
+public:
+    TesterTrace() : yearCount(1) {}
 
     void test(DomainGroup *dg, ECC *ecc, Scrubber *scrubber, long runCnt, char *filePrefix, int faultCount, std::string *faults);
 protected:
     void reset();
+    const char *getType() { return "trace"; }
+    std::string getConfig() { return ""; }
+    bool setConfig(const std::string &config) { return config.empty(); }
+    void listCounters(std::vector<CounterArray> &list);
+    void listMetrics(std::vector<Metric> &list);
     void printSummary(FILE *fd, long runNum);
+    // replay events [runBegin, runEnd) of the trace
+    void runRange(long runBegin, long runEnd);
 
 protected:
-    long errorCnt[SDC+1];
+    TraceReader trace;
+    EventQueue events;              // pending scrubs and the next event
+    int yearCount;                  // years of the trace
+
+    // [year*(SDC+1)+result], and repeats and replacements per year
+    std::vector<long> resultCntYear;
+    std::vector<long> repeatCntYear;
+    std::vector<long> RetireCntYear;
 };
 
 #endif /* __TESTER_HH__ */
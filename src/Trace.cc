@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Trace.hh"
+
+//------------------------------------------------------------------------------
+bool TraceReader::open(const char *name) {
+    close();
+    int file = ::open(name, O_RDONLY);
+    if (file<0) {
+        printf("Cannot open trace %s\n", name);
+        return false;
+    }
+    struct stat st;
+    if ((fstat(file, &st)!=0) || ((size_t) st.st_size<sizeof(TraceHeader))) {
+        printf("Trace %s has no header\n", name);
+        ::close(file);
+        return false;
+    }
+    size = st.st_size;
+    base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (base==MAP_FAILED) {
+        printf("Cannot map trace %s\n", name);
+        base = NULL;
+        return false;
+    }
+    // records are streamed once, in order
+    madvise(base, size, MADV_SEQUENTIAL);
+
+    const TraceHeader *header = (const TraceHeader *) base;
+    if ((memcmp(header->magic, TRACE_MAGIC, sizeof(header->magic))!=0) || (header->version!=TRACE_VERSION)
+     || (header->recordSize!=sizeof(TraceRecord))
+     || (size!=sizeof(TraceHeader)+header->recordCount*sizeof(TraceRecord))) {
+        printf("Trace %s is malformed (or of another version)\n", name);
+        close();
+        return false;
+    }
+    records = (const TraceRecord *) ((const char *) base+sizeof(TraceHeader));
+    recordCount = header->recordCount;
+    return true;
+}
+
+void TraceReader::close() {
+    if (base!=NULL) {
+        munmap(base, size);
+    }
+    base = NULL;
+    size = 0;
+    records = NULL;
+    recordCount = 0;
+}
+
+//------------------------------------------------------------------------------
+// a field of a text event (*: every value)
+static bool parseField(char *token, unsigned long any, unsigned long *value) {
+    if (token==NULL) {
+        return false;
+    }
+    if (strcmp(token, "*")==0) {
+        *value = any;
+        return true;
+    }
+    char *end;
+    *value = strtoul(token, &end, 10);
+    return (*end=='\0') && (end!=token) && (*value<any);
+}
+
+bool TraceReader::convertText(const char *textName, const char *traceName) {
+    FILE *in = fopen(textName, "r");
+    if (in==NULL) {
+        printf("Cannot open %s\n", textName);
+        return false;
+    }
+    FILE *out = fopen(traceName, "wb");
+    if (out==NULL) {
+        printf("Cannot create %s\n", traceName);
+        fclose(in);
+        return false;
+    }
+
+    TraceHeader header;
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.recordSize = sizeof(TraceRecord);
+    header.recordCount = 0;
+    fwrite(&header, sizeof(header), 1, out);
+
+    char line[1024];
+    long lineNum = 0;
+    double prevHr = 0.;
+    bool ok = true;
+    while (ok && (fgets(line, sizeof(line), in)!=NULL)) {
+        lineNum++;
+        char *token = strtok(line, " \t\r\n");
+        if ((token==NULL) || (token[0]=='#')) {
+            continue;
+        }
+        TraceRecord record;
+        memset(&record, 0, sizeof(record));
+        char *end;
+        record.hr = strtod(token, &end);
+        unsigned long domain, rank, chip, bank, row, column, dq, beat;
+        ok = (*end=='\0') && (record.hr>=prevHr)
+          && parseField(strtok(NULL, " \t\r\n"), TRACE_ANY32, &domain) && (domain!=TRACE_ANY32)
+          && parseField(strtok(NULL, " \t\r\n"), TRACE_ANY8, &rank)
+          && parseField(strtok(NULL, " \t\r\n"), TRACE_ANY8, &chip)
+          && parseField(strtok(NULL, " \t\r\n"), TRACE_ANY8, &bank)
+          && parseField(strtok(NULL, " \t\r\n"), TRACE_ANY32, &row)
+          && parseField(strtok(NULL, " \t\r\n"), TRACE_ANY16, &column)
+          && parseField(strtok(NULL, " \t\r\n"), TRACE_ANY8, &dq)
+          && parseField(strtok(NULL, " \t\r\n"), TRACE_ANY8, &beat);
+        token = ok ? strtok(NULL, " \t\r\n") : NULL;
+        ok = ok && (token!=NULL) && ((strcmp(token, "T")==0) || (strcmp(token, "P")==0));
+        if (!ok) {
+            printf("%s:%ld: expected 'hours domain rank chip bank row column dq beat T|P' in time order\n", textName, lineNum);
+            break;
+        }
+        record.domain = domain;
+        record.rank = rank;
+        record.chip = chip;
+        record.bank = bank;
+        record.row = row;
+        record.column = column;
+        record.dq = dq;
+        record.beat = beat;
+        record.flags = (token[0]=='T') ? TRACE_TRANSIENT : 0;
+        fwrite(&record, sizeof(record), 1, out);
+        header.recordCount++;
+        prevHr = record.hr;
+    }
+
+    fclose(in);
+    if (!ok) {
+        // no truncated (but well-formed) trace is left behind
+        fclose(out);
+        unlink(traceName);
+        return false;
+    }
+    fseek(out, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, out);
+    fclose(out);
+    printf("%s: %llu events\n", traceName, (unsigned long long) header.recordCount);
+    return true;
+}
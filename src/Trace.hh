@@ -0,0 +1,65 @@
+#ifndef __TRACE_HH__
+#define __TRACE_HH__
+
+#include <stdint.h>
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+// Compact binary trace of field memory errors (native byte order)
+// - a TraceHeader, then recordCount TraceRecords in non-decreasing hr
+// - a field of all ones (TRACE_ANY*) covers every value of it
+//   (e.g. column TRACE_ANY16: a row fault, chip TRACE_ANY8: the whole rank)
+#define TRACE_MAGIC         "ECCTRACE"
+#define TRACE_VERSION       1
+#define TRACE_ANY8          0xFFu
+#define TRACE_ANY16         0xFFFFu
+#define TRACE_ANY32         0xFFFFFFFFu
+#define TRACE_TRANSIENT     0x01u
+
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t recordCount;
+};
+
+struct TraceRecord {
+    double hr;              // hours since the start of the trace
+    uint32_t domain;        // fault domain in the group (per --dimms: DIMMs/2 for most ECCs)
+    uint32_t row;
+    uint16_t column;
+    uint8_t bank;
+    uint8_t rank;
+    uint8_t chip;
+    uint8_t dq;             // pin in the chip
+    uint8_t beat;           // beat of the burst
+    uint8_t flags;          // TRACE_TRANSIENT
+};
+
+static_assert(sizeof(TraceRecord)==24, "TraceRecord must stay packed");
+
+//------------------------------------------------------------------------------
+// read-only memory map of a trace: records are read in place
+class TraceReader {
+public:
+    TraceReader() : base(NULL), size(0), records(NULL), recordCount(0) {}
+    ~TraceReader() { close(); }
+
+    // false (with a message): missing or malformed
+    bool open(const char *name);
+    void close();
+    size_t getRecordCount() const { return recordCount; }
+    const TraceRecord &getRecord(size_t i) const { return records[i]; }
+
+    // text log -> trace: one event per line,
+    //   hours domain rank chip bank row column dq beat T|P
+    // with * for a field covering every value ('#': comment line)
+    static bool convertText(const char *textName, const char *traceName);
+protected:
+    void *base;
+    size_t size;
+    const TraceRecord *records;
+    size_t recordCount;
+};
+
+#endif /* __TRACE_HH__ */
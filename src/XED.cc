@@ -150,7 +150,7 @@ ErrorType XED::diagnoseFault(FaultDomain *fd, CacheLine &errorBlk, int erasures)
         }
     }
     if (overlapFaults.size()!=0) {
-        int faultPos = rand()%overlapFaults.size();
+        int faultPos = randomGenerator.uniformInt(overlapFaults.size());
         int pos = 0;
         int correctCount = 0;
         for (auto it = overlapFaults.cbegin(); it != overlapFaults.cend(); ) {
@@ -191,7 +191,7 @@ void XED::detectInDRAM(CacheLine &errorBlk, std::list<int> &chipLocations) {
 
             if ((result==CE)||(result==DUE)) {
                 // catch-word collision
-                unsigned long long draw = ((unsigned long long)rand()*((unsigned long long)RAND_MAX+1))| rand();
+                unsigned long long draw = randomGenerator.next64();
                 if (draw%0x100000000ull!=0) {    // 2^-32
                     // no collision
                     chipLocations.push_back(i);
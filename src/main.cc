@@ -6,6 +6,7 @@
 
 #include "Config.hh"
 #include "FaultRateInfo.hh"
+#include "Random.hh"
 
 #include "DomainGroup.hh"
 #include "Tester.hh"
@@ -27,112 +28,101 @@ void testDUO(int ID);
 //#define BAMBOO
 #define AGECC
 
-int main(int argc, char **argv)
-{
-    if (argc<5) {
-        printf("Usage: %s ECCID runCnt RandomSeed FaultType1 FaultType2 ...\n", argv[0]);
-        exit(1);
-    }
-
-    // random seed
-    srand(atoi(argv[3]));
-    //srand(time(NULL));
+//int DIMMcnt = 100000;     // fleet scale: --dimms 100000
+int DIMMcnt = 4;
+//int DIMMcnt = 2;
+//int DIMMcnt = 1;
 
-    char filePrefix[256];
+//------------------------------------------------------------------------------
+// build the DomainGroup/ECC pair of an ECC ID
+void buildSetup(int eccID, const char *seedStr, DomainGroup **dgPtr, ECC **eccPtr, char *filePrefix) {
     DomainGroup *dg = NULL;
     ECC *ecc = NULL;
-    Tester *tester = NULL;
-    Scrubber *scrubber = NULL;
-
-    //int DIMMcnt = 100000;
-    int DIMMcnt = 4;
-    //int DIMMcnt = 2;
-    //int DIMMcnt = 1;
 
 #ifdef BAMBOO
-    switch (atoi(argv[1])) {
+    switch (eccID) {
         // 2 rank / x4 chip / 64-/72-bit channel
         case 0: // bit-level
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 8);
             ecc = new ECCNone();
-            sprintf(filePrefix, "000.4x16.None.%s", argv[3]);
+            sprintf(filePrefix, "000.4x16.None.%s", seedStr);
             break;
         case 1:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new SECDED72b();
-            sprintf(filePrefix, "001.4x18.SECDED72b.%s", argv[3]);
+            sprintf(filePrefix, "001.4x18.SECDED72b.%s", seedStr);
             break;
         case 2:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 17, 4, 8);
             ecc = new SPC66bx4();
-            sprintf(filePrefix, "002.4x17.SPC66bx4.%s", argv[3]);
+            sprintf(filePrefix, "002.4x17.SPC66bx4.%s", seedStr);
             break;
         case 3:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 17, 4, 8);
             ecc = new SPCTPD68bx4();
-            sprintf(filePrefix, "003.4x17.SPCTPD68bx4.%s", argv[3]);
+            sprintf(filePrefix, "003.4x17.SPCTPD68bx4.%s", seedStr);
             break;
         case 10:    // chip-level
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new AMDChipkill72b(true);
-            sprintf(filePrefix, "010.4x18.AMD.%s", argv[3]);
+            sprintf(filePrefix, "010.4x18.AMD.%s", seedStr);
             break;
         case 11:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b();
-            sprintf(filePrefix, "011.4x18.QPC.%s", argv[3]);
+            sprintf(filePrefix, "011.4x18.QPC.%s", seedStr);
             break;
         case 20:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 36, 4, 8);
             ecc = new AMDDChipkill144b();
-            sprintf(filePrefix, "020.4x36.DAMD.%s", argv[3]);
+            sprintf(filePrefix, "020.4x36.DAMD.%s", seedStr);
             break;
         case 21:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 36, 4, 8);
             ecc = new OPC144b();
-            sprintf(filePrefix, "021.4x36.OPC.%s", argv[3]);
+            sprintf(filePrefix, "021.4x36.OPC.%s", seedStr);
             break;
         // 2 rank / x8 chip / 72-bit channel
         case 30:    // bit-level
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 8, 8);
             ecc = new SECDED72b();
-            sprintf(filePrefix, "030.9x8.SECDED72b.%s", argv[3]);
+            sprintf(filePrefix, "030.9x8.SECDED72b.%s", seedStr);
             break;
         // 2 rank / x8 chip / 144-bit channel
         case 40:
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 18, 8, 8);
             ecc = new S8SC144b();
-            sprintf(filePrefix, "040.8x18.S8SC.%s", argv[3]);
+            sprintf(filePrefix, "040.8x18.S8SC.%s", seedStr);
             break;
         case 41:
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 18, 8, 8);
             ecc = new OPC144b();
-            sprintf(filePrefix, "041.8x18.OPC.%s", argv[3]);
+            sprintf(filePrefix, "041.8x18.OPC.%s", seedStr);
             break;
         case 50:     // EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b(4,1);
-            sprintf(filePrefix, "050.4x18.QPC41.%s", argv[3]);
+            sprintf(filePrefix, "050.4x18.QPC41.%s", seedStr);
             break;
         case 51:     // EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b(4,2);
-            sprintf(filePrefix, "051.4x18.QPC42.%s", argv[3]);
+            sprintf(filePrefix, "051.4x18.QPC42.%s", seedStr);
             break;
         case 52:     // EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b(4,3);
-            sprintf(filePrefix, "052.4x18.QPC43.%s", argv[3]);
+            sprintf(filePrefix, "052.4x18.QPC43.%s", seedStr);
             break;
         case 53:     // EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b(4,4);
-            sprintf(filePrefix, "053.4x18.QPC44.%s", argv[3]);
+            sprintf(filePrefix, "053.4x18.QPC44.%s", seedStr);
             break;
         case 60:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 19, 4, 8);
             ecc = new QPC76b();
-            sprintf(filePrefix, "060.19x4.QPC76b.%s", argv[3]);
+            sprintf(filePrefix, "060.19x4.QPC76b.%s", seedStr);
             break;
         default:
             printf("Invalid ECC ID\n");
@@ -140,183 +130,183 @@ int main(int argc, char **argv)
     }
 #endif
 #ifdef FRUGAL_ECC
-    switch (atoi(argv[1])) {
+    switch (eccID) {
         // 2 rank / x8 chip / 64-bit channel
         case 0:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 8, 8);
             ecc = new ECCNone();
-            sprintf(filePrefix, "000.8x8.None.%s", argv[3]);
+            sprintf(filePrefix, "000.8x8.None.%s", seedStr);
             break;
         case 1:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 8, 8);
             ecc = new FrugalECC64bMultix8();
-            sprintf(filePrefix, "001.8x8.FECC+Multi.%s", argv[3]);
+            sprintf(filePrefix, "001.8x8.FECC+Multi.%s", seedStr);
             break;
         // 2 rank / x8 chip / 72-bit channel
         case 10:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 8);
             ecc = new SECDED72b();
-            sprintf(filePrefix, "010.9x8.SECDED72b.%s", argv[3]);
+            sprintf(filePrefix, "010.9x8.SECDED72b.%s", seedStr);
             break;
         case 11:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 8);
             ecc = new S8SC72b();
-            sprintf(filePrefix, "011.9x8.S8SC.%s", argv[3]);
+            sprintf(filePrefix, "011.9x8.S8SC.%s", seedStr);
             break;
         case 12:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 8);
             ecc = new OPC72b();
-            sprintf(filePrefix, "012.9x8.OPC.%s", argv[3]);
+            sprintf(filePrefix, "012.9x8.OPC.%s", seedStr);
             break;
         case 13:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 8);
             ecc = new LOTECC();
-            sprintf(filePrefix, "013.9x8.OTECC.%s", argv[3]);
+            sprintf(filePrefix, "013.9x8.OTECC.%s", seedStr);
             break;
         case 14:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 8);
             ecc = new MultiECC();
-            sprintf(filePrefix, "014.9x8.MultiECC.%s", argv[3]);
+            sprintf(filePrefix, "014.9x8.MultiECC.%s", seedStr);
             break;
         case 15:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 8);
             ecc = new FrugalECC72bNoEFP();
-            sprintf(filePrefix, "015.9x8.FECCnoEFP.%s", argv[3]);
+            sprintf(filePrefix, "015.9x8.FECCnoEFP.%s", seedStr);
             break;
         case 16:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 8);
             ecc = new FrugalECC72bOPC();
-            sprintf(filePrefix, "016.9x8.FECC+OPC.%s", argv[3]);
+            sprintf(filePrefix, "016.9x8.FECC+OPC.%s", seedStr);
             break;
         // 2 rank / x8 chip / 80-bit channel
         case 20:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 10, 8);
             ecc = new S8SC80b();
-            sprintf(filePrefix, "020.10x8.S8SC.%s", argv[3]);
+            sprintf(filePrefix, "020.10x8.S8SC.%s", seedStr);
             break;
         case 21:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 10, 8);
             ecc = new OPC80b();
-            sprintf(filePrefix, "021.10x8.OPC.%s", argv[3]);
+            sprintf(filePrefix, "021.10x8.OPC.%s", seedStr);
             break;
         // 2 rank / x8 chip / 128-bit channel
         case 30:
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 16, 8);
             ecc = new VECC128bx8();
-            sprintf(filePrefix, "030.16x8.VECC.%s", argv[3]);
+            sprintf(filePrefix, "030.16x8.VECC.%s", seedStr);
             break;
         // 2 rank / x8 chip / 144-bit channel
         case 41:
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 18, 8);
             ecc = new OPC144b();
-            sprintf(filePrefix, "040.18x8.OPC.%s", argv[3]);
+            sprintf(filePrefix, "040.18x8.OPC.%s", seedStr);
             break;
         case 41:
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 18, 8);
             ecc = new VECC144bx8();
-            sprintf(filePrefix, "041.18x8.VECC.%s", argv[3]);
+            sprintf(filePrefix, "041.18x8.VECC.%s", seedStr);
             break;
 
 
         case 4:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new AMDChipkill64b();
-            sprintf(filePrefix, "02.4x16.AMD.%s", argv[3]);
+            sprintf(filePrefix, "02.4x16.AMD.%s", seedStr);
             break;
         case 2:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new QPC64b();
-            sprintf(filePrefix, "4x16.02.QPC.%s", argv[3]);
+            sprintf(filePrefix, "4x16.02.QPC.%s", seedStr);
             break;
         case 11:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new VECC64bAMD();
-            sprintf(filePrefix, "4x16.11.VECC+AMD.%s", argv[3]);
+            sprintf(filePrefix, "4x16.11.VECC+AMD.%s", seedStr);
             break;
         case 12:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new VECC64bQPC();
-            sprintf(filePrefix, "4x16.12.VECC+QPC.%s", argv[3]);
+            sprintf(filePrefix, "4x16.12.VECC+QPC.%s", seedStr);
             break;
         case 13:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new VECC64bS8SCD8SD();
-            sprintf(filePrefix, "4x16.13.VECC+S8SCD8SD.%s", argv[3]);
+            sprintf(filePrefix, "4x16.13.VECC+S8SCD8SD.%s", seedStr);
             break;
         case 14:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new VECC64bMultix4();
-            sprintf(filePrefix, "4x16.14.VECC+Multi.%s", argv[3]);
+            sprintf(filePrefix, "4x16.14.VECC+Multi.%s", seedStr);
             break;
         case 20:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new FrugalECC64bNoEFP();
-            sprintf(filePrefix, "4x16.20.FECC+noEFP.%s", argv[3]);
+            sprintf(filePrefix, "4x16.20.FECC+noEFP.%s", seedStr);
             break;
         case 21:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new FrugalECC64b();
-            sprintf(filePrefix, "4x16.21.FECC+QPC.%s", argv[3]);
+            sprintf(filePrefix, "4x16.21.FECC+QPC.%s", seedStr);
             break;
         case 22:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new FrugalECC64b2();
-            sprintf(filePrefix, "4x16.22.FECC2+QPC.%s", argv[3]);
+            sprintf(filePrefix, "4x16.22.FECC2+QPC.%s", seedStr);
             break;
         case 23:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new FrugalECC64b3();
-            sprintf(filePrefix, "4x16.23.FECC3+QPC.%s", argv[3]);
+            sprintf(filePrefix, "4x16.23.FECC3+QPC.%s", seedStr);
             break;
         case 24:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4);
             ecc = new FrugalECC64bMultix4();
-            sprintf(filePrefix, "4x16.24.FECC+Multi.%s", argv[3]);
+            sprintf(filePrefix, "4x16.24.FECC+Multi.%s", seedStr);
             break;
         // 2 rank / x4 chip / 68-bit channel
         // 2 rank / x4 chip / 72-bit channel
         case 200:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4);
             ecc = new SECDED72b();
-            sprintf(filePrefix, "4x18.00.SECDED72b.%s", argv[3]);
+            sprintf(filePrefix, "4x18.00.SECDED72b.%s", seedStr);
             break;
         case 201:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4);
             ecc = new AMDChipkill72b();
-            sprintf(filePrefix, "4x18.01.AMD.%s", argv[3]);
+            sprintf(filePrefix, "4x18.01.AMD.%s", seedStr);
             break;
         case 202:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4);
             ecc = new QPC72b();
-            sprintf(filePrefix, "4x18.02.QPC.%s", argv[3]);
+            sprintf(filePrefix, "4x18.02.QPC.%s", seedStr);
             break;
         case 210:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4);
             ecc = new COP();
-            sprintf(filePrefix, "4x18.10.COP.%s", argv[3]);
+            sprintf(filePrefix, "4x18.10.COP.%s", seedStr);
             break;
         case 211:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4);
             ecc = new COPER();
-            sprintf(filePrefix, "4x18.11.COPER.%s", argv[3]);
+            sprintf(filePrefix, "4x18.11.COPER.%s", seedStr);
             break;
         // 2 rank / x4 chip / 128-bit channel
         case 500:
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 32, 4);
             ecc = new VECC128bx4();
-            sprintf(filePrefix, "4x32.00.VECC.%s", argv[3]);
+            sprintf(filePrefix, "4x32.00.VECC.%s", seedStr);
             break;
         // 2 rank / x4 chip / 136-bit channel
         case 600:
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 34, 4);
             ecc = new VECC136bx4();
-            sprintf(filePrefix, "4x34.00.VECC.%s", argv[3]);
+            sprintf(filePrefix, "4x34.00.VECC.%s", seedStr);
             break;
         //// 2 rank / x4 chip / 144-bit channel
         //case 700:
         //    dg = new DomainGroupDDR(DIMMcnt/4, 2, 36, 4);
         //    ecc = new S4SCD4SD144b();
-        //    sprintf(filePrefix, "4x36.00.S4SCD4SD.%s", argv[3]);
+        //    sprintf(filePrefix, "4x36.00.S4SCD4SD.%s", seedStr);
         //    break;
 
 
@@ -326,26 +316,26 @@ int main(int argc, char **argv)
     }
 #endif
 #ifdef AIECC
-    switch (atoi(argv[1])) {
+    switch (eccID) {
         case 0:
             dg = new DomainGroupDDRCA(DIMMcnt/4, 2, 18, 4, 3.7);
             ecc = new DDR4QPC72b();
-            sprintf(filePrefix, "000.18x4.DDR4.%s", argv[3]);
+            sprintf(filePrefix, "000.18x4.DDR4.%s", seedStr);
             break;
         case 1:
             dg = new DomainGroupDDRCA(DIMMcnt/4, 2, 18, 4, 3.7);
             ecc = new AzulQPC72b();
-            sprintf(filePrefix, "001.18x4.Azul.%s", argv[3]);
+            sprintf(filePrefix, "001.18x4.Azul.%s", seedStr);
             break;
         case 2:
             dg = new DomainGroupDDRCA(DIMMcnt/4, 2, 18, 4, 3.7);
             ecc = new AIECCQPC72b();
-            sprintf(filePrefix, "002.18x4.AIECC.%s", argv[3]);
+            sprintf(filePrefix, "002.18x4.AIECC.%s", seedStr);
             break;
         case 3:
             dg = new DomainGroupDDRCA(DIMMcnt/4, 2, 18, 4, 3.7);
             ecc = new NickQPC72b();
-            sprintf(filePrefix, "003.18x4.IBM.%s", argv[3]);
+            sprintf(filePrefix, "003.18x4.IBM.%s", seedStr);
             break;
         default:
             printf("Invalid ECC ID\n");
@@ -353,373 +343,373 @@ int main(int argc, char **argv)
     }
 #endif
 #ifdef AGECC
-    switch (atoi(argv[1])) {
+    switch (eccID) {
         case 0:     // None
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 8);
             ecc = new ECCNone();
-            sprintf(filePrefix, "000.4x16.None.%s", argv[3]);
+            sprintf(filePrefix, "000.4x16.None.%s", seedStr);
             break;
         case 1:     // None
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new ECCNone();
-            sprintf(filePrefix, "001.4x18.None.%s", argv[3]);
+            sprintf(filePrefix, "001.4x18.None.%s", seedStr);
             break;
         case 2:     // Zero EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new SECDED72b();
-            sprintf(filePrefix, "002.4x18.SECDED72b.%s", argv[3]);
+            sprintf(filePrefix, "002.4x18.SECDED72b.%s", seedStr);
             break;
         case 9:     // Zero EGB + post-processing
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new AMDChipkill72b(true);
-            sprintf(filePrefix, "009.4x18.AMD.%s", argv[3]);
+            sprintf(filePrefix, "009.4x18.AMD.%s", seedStr);
             break;
         case 10:     // Zero EGB + no post-processing
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new AMDChipkill72b(false);
-            sprintf(filePrefix, "010.4x18.AMD2.%s", argv[3]);
+            sprintf(filePrefix, "010.4x18.AMD2.%s", seedStr);
             break;
         case 20:     // EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b(4,1);
-            sprintf(filePrefix, "020.4x18.QPC41.%s", argv[3]);
+            sprintf(filePrefix, "020.4x18.QPC41.%s", seedStr);
             break;
         case 21:     // EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b(4,2);
-            sprintf(filePrefix, "021.4x18.QPC42.%s", argv[3]);
+            sprintf(filePrefix, "021.4x18.QPC42.%s", seedStr);
             break;
         case 22:     // EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b(4,3);
-            sprintf(filePrefix, "022.4x18.QPC43.%s", argv[3]);
+            sprintf(filePrefix, "022.4x18.QPC43.%s", seedStr);
             break;
         case 23:     // EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b(4,4);
-            sprintf(filePrefix, "023.4x18.QPC44.%s", argv[3]);
+            sprintf(filePrefix, "023.4x18.QPC44.%s", seedStr);
             break;
         case 24:     // EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b(3,3);
-            sprintf(filePrefix, "024.4x18.QPC33.%s", argv[3]);
+            sprintf(filePrefix, "024.4x18.QPC33.%s", seedStr);
             break;
         case 25:     // EGB
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72b(2,2);
-            sprintf(filePrefix, "025.4x18.QPC22.%s", argv[3]);
+            sprintf(filePrefix, "025.4x18.QPC22.%s", seedStr);
             break;
         case 100:   // on-chip ECC
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 18);
             ecc = new OnChip64b();
-            sprintf(filePrefix, "100.4x16.OnChip.%s", argv[3]);
+            sprintf(filePrefix, "100.4x16.OnChip.%s", seedStr);
             break;
         case 110:   // on-chip ECC + SEC-DED
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bSECDED();
-            sprintf(filePrefix, "110.4x18.OnChip+SECDED.%s", argv[3]);
+            sprintf(filePrefix, "110.4x18.OnChip+SECDED.%s", seedStr);
             break;
         case 111:   // on-chip ECC + AMD (w/ postprocessing)
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bAMD(true);
-            sprintf(filePrefix, "111.4x18.OnChip+AMD.%s", argv[3]);
+            sprintf(filePrefix, "111.4x18.OnChip+AMD.%s", seedStr);
             break;
         case 112:   // on-chip ECC + AMD (w/o postprocessing)
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bAMD(false);
-            sprintf(filePrefix, "112.4x18.OnChip+AMD2.%s", argv[3]);
+            sprintf(filePrefix, "112.4x18.OnChip+AMD2.%s", seedStr);
             break;
         case 113:   // on-chip ECC + QPC
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bQPC72b(4,2);
-            sprintf(filePrefix, "113.4x18.OnChip+QPC42.%s", argv[3]);
+            sprintf(filePrefix, "113.4x18.OnChip+QPC42.%s", seedStr);
             break;
         case 114:   // on-chip ECC + QPC
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bQPC72b(4,3);
-            sprintf(filePrefix, "114.4x18.OnChip+QPC43.%s", argv[3]);
+            sprintf(filePrefix, "114.4x18.OnChip+QPC43.%s", seedStr);
             break;
         case 115:   // on-chip ECC + QPC
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bQPC72b(4,4);
-            sprintf(filePrefix, "115.4x18.OnChip+QPC44.%s", argv[3]);
+            sprintf(filePrefix, "115.4x18.OnChip+QPC44.%s", seedStr);
             break;
         case 116:   // on-chip ECC + QPC
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bQPC72b(3,3);
-            sprintf(filePrefix, "116.4x18.OnChip+QPC33.%s", argv[3]);
+            sprintf(filePrefix, "116.4x18.OnChip+QPC33.%s", seedStr);
             break;
         case 117:   // on-chip ECC + QPC
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bQPC72b(2,2);
-            sprintf(filePrefix, "117.4x18.OnChip+QPC22.%s", argv[3]);
+            sprintf(filePrefix, "117.4x18.OnChip+QPC22.%s", seedStr);
             break;
         case 130:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 4, 18);
             ecc = new XED_SDDC(true);    // w/ fault diagnosis
-            sprintf(filePrefix, "130.4x9.XED_SDDC.%s", argv[3]);
+            sprintf(filePrefix, "130.4x9.XED_SDDC.%s", seedStr);
             break;
         case 132:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 4, 18);
             ecc = new XED_SDDC(false);   // w/o fault diagnosis
-            sprintf(filePrefix, "132.4x9.XED_SDDC.%s", argv[3]);
+            sprintf(filePrefix, "132.4x9.XED_SDDC.%s", seedStr);
             break;
         case 140:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72bREGB(true, true);     // w/ retire
-            sprintf(filePrefix, "140.4x18.QPC_REGB.%s", argv[3]);
+            sprintf(filePrefix, "140.4x18.QPC_REGB.%s", seedStr);
             break;
         case 141:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72bREGB(true, false);    // w/o retire
-            sprintf(filePrefix, "141.4x18.QPC_REGB.%s", argv[3]);
+            sprintf(filePrefix, "141.4x18.QPC_REGB.%s", seedStr);
             break;
         case 200:       // Zero EGB + post-processing
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 18, 4, 8);
             ecc = new AMDChipkill72b(true);
-            sprintf(filePrefix, "200.4x18.AMD.%s", argv[3]);
+            sprintf(filePrefix, "200.4x18.AMD.%s", seedStr);
             break;
         case 201:       // Zero EGB + post-processing
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 18, 4, 8);
             ecc = new AMDChipkill72b(true);
             ecc->setMaxRetiredBlkCount(0);
-            sprintf(filePrefix, "201.4x18.AMD.%s", argv[3]);
+            sprintf(filePrefix, "201.4x18.AMD.%s", seedStr);
             break;
         case 202:       // Zero EGB + post-processing
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 18, 4, 8);
             ecc = new AMDChipkill72b(true);
             ecc->setMaxRetiredBlkCount(64);
-            sprintf(filePrefix, "202.4x18.AMD.%s", argv[3]);
+            sprintf(filePrefix, "202.4x18.AMD.%s", seedStr);
             break;
         case 203:       // Zero EGB + post-processing
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 18, 4, 8);
             ecc = new AMDChipkill72b(true);
             ecc->setMaxRetiredBlkCount(2048);
-            sprintf(filePrefix, "203.4x18.AMD.%s", argv[3]);
+            sprintf(filePrefix, "203.4x18.AMD.%s", seedStr);
             break;
         case 204:       // Zero EGB + post-processing
             dg = new DomainGroupDDR(DIMMcnt/4, 2, 18, 4, 8);
             ecc = new AMDChipkill72b(true);
             ecc->setMaxRetiredBlkCount(16384);
-            sprintf(filePrefix, "204.4x18.AMD.%s", argv[3]);
+            sprintf(filePrefix, "204.4x18.AMD.%s", seedStr);
             break;
         case 210:   // on-chip ECC + AMD (w/ postprocessing)
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bAMD(true);
-            sprintf(filePrefix, "210.4x18.OnChip+AMD.%s", argv[3]);
+            sprintf(filePrefix, "210.4x18.OnChip+AMD.%s", seedStr);
             break;
         case 211:   // on-chip ECC + AMD (w/ postprocessing)
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bAMD(true);
             ecc->setMaxRetiredBlkCount(0);
-            sprintf(filePrefix, "211.4x18.OnChip+AMD.%s", argv[3]);
+            sprintf(filePrefix, "211.4x18.OnChip+AMD.%s", seedStr);
             break;
         case 212:   // on-chip ECC + AMD (w/ postprocessing)
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bAMD(true);
             ecc->setMaxRetiredBlkCount(64/2);
-            sprintf(filePrefix, "212.4x18.OnChip+AMD.%s", argv[3]);
+            sprintf(filePrefix, "212.4x18.OnChip+AMD.%s", seedStr);
             break;
         case 213:   // on-chip ECC + AMD (w/ postprocessing)
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bAMD(true);
             ecc->setMaxRetiredBlkCount(2048/2);
-            sprintf(filePrefix, "213.4x18.OnChip+AMD.%s", argv[3]);
+            sprintf(filePrefix, "213.4x18.OnChip+AMD.%s", seedStr);
             break;
         case 214:   // on-chip ECC + AMD (w/ postprocessing)
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new OnChip72bAMD(true);
             ecc->setMaxRetiredBlkCount(16384/2);
-            sprintf(filePrefix, "214.4x18.OnChip+AMD.%s", argv[3]);
+            sprintf(filePrefix, "214.4x18.OnChip+AMD.%s", seedStr);
             break;
         case 220:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new XED_DDDC(true);    // w/ fault diagnosis
-            sprintf(filePrefix, "220.4x18.XED_DDDC.%s", argv[3]);
+            sprintf(filePrefix, "220.4x18.XED_DDDC.%s", seedStr);
             break;
         case 221:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new XED_DDDC(true);    // w/ fault diagnosis
             ecc->setMaxRetiredBlkCount(0);
-            sprintf(filePrefix, "221.4x18.XED_DDDC.%s", argv[3]);
+            sprintf(filePrefix, "221.4x18.XED_DDDC.%s", seedStr);
             break;
         case 222:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new XED_DDDC(true);    // w/ fault diagnosis
             ecc->setMaxRetiredBlkCount(64/2);
-            sprintf(filePrefix, "222.4x18.XED_DDDC.%s", argv[3]);
+            sprintf(filePrefix, "222.4x18.XED_DDDC.%s", seedStr);
             break;
         case 223:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new XED_DDDC(true);    // w/ fault diagnosis
             ecc->setMaxRetiredBlkCount(2048/2);
-            sprintf(filePrefix, "223.4x18.XED_DDDC.%s", argv[3]);
+            sprintf(filePrefix, "223.4x18.XED_DDDC.%s", seedStr);
             break;
         case 224:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 18);
             ecc = new XED_DDDC(true);    // w/ fault diagnosis
             ecc->setMaxRetiredBlkCount(16384/2);
-            sprintf(filePrefix, "224.4x18.XED_DDDC.%s", argv[3]);
+            sprintf(filePrefix, "224.4x18.XED_DDDC.%s", seedStr);
             break;
         case 230:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72bREGB(true, true);     // w/ retire
             ecc->setDoRetire(false);
-            sprintf(filePrefix, "230.4x18.QPC_REGB.%s", argv[3]);
+            sprintf(filePrefix, "230.4x18.QPC_REGB.%s", seedStr);
             break;
         case 231:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72bREGB(true, true);     // w/ retire
             ecc->setMaxRetiredBlkCount(0);
-            sprintf(filePrefix, "231.4x18.QPC_REGB.%s", argv[3]);
+            sprintf(filePrefix, "231.4x18.QPC_REGB.%s", seedStr);
             break;
         case 232:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72bREGB(true, true);     // w/ retire
             ecc->setMaxRetiredBlkCount(64);
-            sprintf(filePrefix, "232.4x18.QPC_REGB.%s", argv[3]);
+            sprintf(filePrefix, "232.4x18.QPC_REGB.%s", seedStr);
             break;
         case 233:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72bREGB(true, true);     // w/ retire
             ecc->setMaxRetiredBlkCount(2048);
-            sprintf(filePrefix, "233.4x18.QPC_REGB.%s", argv[3]);
+            sprintf(filePrefix, "233.4x18.QPC_REGB.%s", seedStr);
             break;
         case 234:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 18, 4, 8);
             ecc = new QPC72bREGB(true, true);     // w/ retire
             ecc->setMaxRetiredBlkCount(16384);
-            sprintf(filePrefix, "234.4x18.QPC_REGB.%s", argv[3]);
+            sprintf(filePrefix, "234.4x18.QPC_REGB.%s", seedStr);
             break;
         case 240:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 4, 18);
             ecc = new XED_SDDC(true);    // w/ fault diagnosis
-            sprintf(filePrefix, "240.4x9.XED_SDDC.%s", argv[3]);
+            sprintf(filePrefix, "240.4x9.XED_SDDC.%s", seedStr);
             break;
         case 241:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 4, 18);
             ecc = new XED_SDDC(true);    // w/ fault diagnosis
             ecc->setMaxRetiredBlkCount(0);
-            sprintf(filePrefix, "241.4x9.XED_SDDC.%s", argv[3]);
+            sprintf(filePrefix, "241.4x9.XED_SDDC.%s", seedStr);
             break;
         case 242:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 4, 18);
             ecc = new XED_SDDC(true);    // w/ fault diagnosis
             ecc->setMaxRetiredBlkCount(64/2);
-            sprintf(filePrefix, "242.4x9.XED_SDDC.%s", argv[3]);
+            sprintf(filePrefix, "242.4x9.XED_SDDC.%s", seedStr);
             break;
         case 243:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 4, 18);
             ecc = new XED_SDDC(true);    // w/ fault diagnosis
             ecc->setMaxRetiredBlkCount(2048/2);
-            sprintf(filePrefix, "243.4x9.XED_SDDC.%s", argv[3]);
+            sprintf(filePrefix, "243.4x9.XED_SDDC.%s", seedStr);
             break;
         case 244:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 9, 4, 18);
             ecc = new XED_SDDC(true);    // w/ fault diagnosis
             ecc->setMaxRetiredBlkCount(16384/2);
-            sprintf(filePrefix, "244.4x9.XED_SDDC.%s", argv[3]);
+            sprintf(filePrefix, "244.4x9.XED_SDDC.%s", seedStr);
             break;
         case 300:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(1);
-            sprintf(filePrefix, "300.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "300.4x16.DUO.%s", seedStr);
             break;
         case 301:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(1);
             ecc->setMaxRetiredBlkCount(0);
-            sprintf(filePrefix, "301.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "301.4x16.DUO.%s", seedStr);
             break;
         case 302:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(1);
             ecc->setMaxRetiredBlkCount(64);
-            sprintf(filePrefix, "302.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "302.4x16.DUO.%s", seedStr);
             break;
         case 303:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(1);
             ecc->setMaxRetiredBlkCount(2048);
-            sprintf(filePrefix, "303.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "303.4x16.DUO.%s", seedStr);
             break;
         case 304:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(1);
             ecc->setMaxRetiredBlkCount(16384);
-            sprintf(filePrefix, "304.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "304.4x16.DUO.%s", seedStr);
             break;
         case 310:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(2);
-            sprintf(filePrefix, "310.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "310.4x16.DUO.%s", seedStr);
             break;
         case 311:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(2);
             ecc->setMaxRetiredBlkCount(0);
-            sprintf(filePrefix, "311.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "311.4x16.DUO.%s", seedStr);
             break;
         case 312:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(2);
             ecc->setMaxRetiredBlkCount(64);
-            sprintf(filePrefix, "312.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "312.4x16.DUO.%s", seedStr);
             break;
         case 313:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(2);
             ecc->setMaxRetiredBlkCount(2048);
-            sprintf(filePrefix, "313.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "313.4x16.DUO.%s", seedStr);
             break;
         case 314:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(2);
             ecc->setMaxRetiredBlkCount(16384);
-            sprintf(filePrefix, "314.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "314.4x16.DUO.%s", seedStr);
             break;
         case 320:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(3);
-            sprintf(filePrefix, "320.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "320.4x16.DUO.%s", seedStr);
             break;
         case 321:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(3);
             ecc->setMaxRetiredBlkCount(0);
-            sprintf(filePrefix, "321.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "321.4x16.DUO.%s", seedStr);
             break;
         case 322:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(3);
             ecc->setMaxRetiredBlkCount(64);
-            sprintf(filePrefix, "322.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "322.4x16.DUO.%s", seedStr);
             break;
         case 323:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(3);
             ecc->setMaxRetiredBlkCount(2048);
-            sprintf(filePrefix, "323.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "323.4x16.DUO.%s", seedStr);
             break;
         case 324:
             dg = new DomainGroupDDR(DIMMcnt/2, 2, 16, 4, 9);
             ecc = new DUO64bx4(3);
             ecc->setMaxRetiredBlkCount(16384);
-            sprintf(filePrefix, "324.4x16.DUO.%s", argv[3]);
+            sprintf(filePrefix, "324.4x16.DUO.%s", seedStr);
             break;
 		case 330: 
             dg = new DomainGroupDDR(DIMMcnt/4, 4, 9, 4, 17);
             ecc = new DUO36bx4(6,false,false,0);
 			//ecc->setDoRetire(false);//no retirement
             //ecc->setMaxRetiredBlkCount(0);
-            sprintf(filePrefix, "330.4x9(BL17).DUO.%s", argv[3]);
+            sprintf(filePrefix, "330.4x9(BL17).DUO.%s", seedStr);
             break;
 		case 331:
             dg = new DomainGroupDDR(DIMMcnt/4, 4, 9, 4, 17);
             //ecc = new DUO36bx4(3);
             ecc = new DUO36bx4(6,false,true,2048);
             //ecc->setMaxRetiredBlkCount(2048);
-            sprintf(filePrefix, "331.4x9(BL17).DUO.%s", argv[3]);
+            sprintf(filePrefix, "331.4x9(BL17).DUO.%s", seedStr);
             break;
         default:
             printf("Invalid ECC ID\n");
@@ -727,9 +717,210 @@ int main(int argc, char **argv)
     }
 #endif /* AGECC */
 
+    *dgPtr = dg;
+    *eccPtr = ecc;
+}
+
+// builder for worker threads (private DomainGroup/ECC per thread)
+void buildWorkerSetup(int eccID, DomainGroup **dg, ECC **ecc) {
+    char filePrefix[256];
+    buildSetup(eccID, "", dg, ecc, filePrefix);
+}
+
+
+int main(int argc, char **argv)
+{
+    // merge partial results of shards
+    if ((argc>=2) && (strcmp(argv[1], "merge")==0)) {
+        Tester::mergeShards(argc-2, argv+2);
+        return 0;
+    }
+    // convert a text error log to a binary trace
+    if ((argc==4) && (strcmp(argv[1], "trace-convert")==0)) {
+        return TraceReader::convertText(argv[2], argv[3]) ? 0 : 1;
+    }
+
+    // options (removed from argv before the positional arguments are parsed)
+    int threadCount = 1;
+    long replayRun = -1;
+    long checkpointInterval = 0;    // runs between checkpoints (0: none)
+    bool resume = false;
+    int shardID = 0, shardCount = 1;
+    long firstRun = 0;
+    double relCI = 0., confidence = 0.95;
+    std::string ciMetrics = "DUE,SDC";
+    double isRate = 1., isBias = 1.;
+    bool skipEmpty = true;
+    std::vector<unsigned long long> retireThresholds;
+    std::vector<std::string> rateProfileSpecs;
+    std::vector<std::pair<std::string, RateProfile *>> rateProfiles;
+    std::string recordLog, replayLog;
+    int argn = 1;
+    for (int i=1; i<argc; i++) {
+        if ((strcmp(argv[i], "--threads")==0) && (i+1<argc)) {
+            threadCount = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "--replay-run")==0) && (i+1<argc)) {
+            replayRun = atol(argv[++i]);
+        } else if ((strcmp(argv[i], "--checkpoint")==0) && (i+1<argc)) {
+            checkpointInterval = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--resume")==0) {
+            resume = true;
+        } else if ((strcmp(argv[i], "--shard")==0) && (i+1<argc)) {
+            if ((sscanf(argv[++i], "%d/%d", &shardID, &shardCount)!=2) || (shardID<0) || (shardID>=shardCount)) {
+                printf("Invalid shard %s (expected k/K with 0<=k<K)\n", argv[i]);
+                exit(1);
+            }
+        } else if ((strcmp(argv[i], "--first-run")==0) && (i+1<argc)) {
+            firstRun = atol(argv[++i]);
+            if (firstRun<0) {
+                printf("Invalid first run %s (expected >=0)\n", argv[i]);
+                exit(1);
+            }
+        } else if ((strcmp(argv[i], "--rel-ci")==0) && (i+1<argc)) {
+            relCI = atof(argv[++i]);
+        } else if ((strcmp(argv[i], "--confidence")==0) && (i+1<argc)) {
+            confidence = atof(argv[++i]);
+            if ((confidence<=0.) || (confidence>=1.)) {
+                printf("Invalid confidence %s (expected 0<c<1)\n", argv[i]);
+                exit(1);
+            }
+        } else if ((strcmp(argv[i], "--ci-metrics")==0) && (i+1<argc)) {
+            ciMetrics = argv[++i];
+        } else if ((strcmp(argv[i], "--retire-sweep")==0) && (i+1<argc)) {
+            for (char *threshold=strtok(argv[++i], ","); threshold!=NULL; threshold=strtok(NULL, ",")) {
+                retireThresholds.push_back(strtoull(threshold, NULL, 10));
+            }
+        } else if ((strcmp(argv[i], "--dimms")==0) && (i+1<argc)) {
+            DIMMcnt = atoi(argv[++i]);
+            if (DIMMcnt<4) {
+                printf("Invalid DIMM count %s (expected >=4)\n", argv[i]);
+                exit(1);
+            }
+        } else if ((strcmp(argv[i], "--rate-profile")==0) && (i+1<argc)) {
+            // [FaultTypePrefix=]profile
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            std::string prefix = (eq==std::string::npos) ? "" : spec.substr(0, eq);
+            RateProfile *profile = RateProfile::parse((eq==std::string::npos) ? spec : spec.substr(eq+1));
+            if (profile==NULL) {
+                printf("Invalid rate profile %s (expected [type=]weibull:shape,pivotYears, bathtub:shape,pivotYears,shape,pivotYears or years:m0,m1,...)\n", argv[i]);
+                exit(1);
+            }
+            rateProfileSpecs.push_back(spec);
+            rateProfiles.push_back(std::make_pair(prefix, profile));
+        } else if ((strcmp(argv[i], "--record-faults")==0) && (i+1<argc)) {
+            recordLog = argv[++i];
+        } else if ((strcmp(argv[i], "--replay-faults")==0) && (i+1<argc)) {
+            replayLog = argv[++i];
+        } else if (strcmp(argv[i], "--no-skip-empty")==0) {
+            skipEmpty = false;
+        } else if ((strcmp(argv[i], "--is-rate")==0) && (i+1<argc)) {
+            isRate = atof(argv[++i]);
+            if (isRate<=0.) {
+                printf("Invalid rate scale %s (expected >0)\n", argv[i]);
+                exit(1);
+            }
+        } else if ((strcmp(argv[i], "--is-bias")==0) && (i+1<argc)) {
+            isBias = atof(argv[++i]);
+            if (isBias<=0.) {
+                printf("Invalid type bias %s (expected >0)\n", argv[i]);
+                exit(1);
+            }
+        } else {
+            argv[argn++] = argv[i];
+        }
+    }
+    argc = argn;
+
+    if (argc<5) {
+        printf("Usage: %s [--threads N] [--replay-run runIdx] [--checkpoint interval] [--resume]\n"
+               "          [--shard k/K] [--first-run runIdx] [--rel-ci r] [--confidence c] [--ci-metrics DUE,SDC,...]\n"
+               "          [--is-rate scale] [--is-bias bias] [--no-skip-empty] [--retire-sweep blkCnt,blkCnt,...]\n"
+               "          [--dimms N] [--rate-profile [type=]weibull:k,years|bathtub:k,years,k,years|years:m0,m1,...]\n"
+               "          [--record-faults FaultLog] [--replay-faults FaultLog]\n"
+               "          ECCID[,ECCID...] runCnt RandomSeed FaultType1 FaultType2 ...\n"
+               "       (with --rel-ci, runCnt is the hard cap)\n"
+               "       (S with --replay-faults: the fault timelines, rates and sampling of the log;\n"
+               "        the seed of the recording repeats its error patterns)\n"
+               "       (scenario FaultType: type on a chip of its own, type@k on the chip of fault k,\n"
+               "        type#k on pins of fault k)\n"
+               "       %s [--dimms N] [--replay-run eventIdx] ECCID eventCnt RandomSeed T TraceFile\n"
+               "       (replay of a field trace; eventCnt 0: every event)\n"
+               "       %s merge PartialResult1 PartialResult2 ...\n"
+               "       %s trace-convert TextLog TraceFile\n", argv[0], argv[0], argv[0], argv[0]);
+        exit(1);
+    }
+
+    // random seed
+    randomGenerator.seed(atoi(argv[3]));
+    //randomGenerator.seed(time(NULL));
+
+    char filePrefix[256];
+    DomainGroup *dg = NULL;
+    ECC *ecc = NULL;
+    Tester *tester = NULL;
+    Scrubber *scrubber = NULL;
+
+    // ECCID may list several ECC IDs of the same geometry (e.g. 10,330,400)
+    // -> the scenario tester decodes every iteration with each of them
+    std::vector<int> eccIDs;
+    for (char *id=strtok(argv[1], ","); id!=NULL; id=strtok(NULL, ",")) {
+        eccIDs.push_back(atoi(id));
+    }
+    assert(!eccIDs.empty());
+
+    buildSetup(eccIDs[0], argv[3], &dg, &ecc, filePrefix);
+    if (DIMMcnt!=4) {
+        sprintf(filePrefix+strlen(filePrefix), ".dimm%d", DIMMcnt);
+    }
+    for (size_t i=0; i<rateProfileSpecs.size(); i++) {
+        size_t len = strlen(filePrefix);
+        snprintf(filePrefix+len, sizeof(filePrefix)-len, ".rate-%s", rateProfileSpecs[i].c_str());
+    }
+
+    if ((eccIDs.size()>1) && (strcmp(argv[4], "S")==0)) {
+        printf("Several ECC IDs are only supported with fault scenarios\n");
+        exit(1);
+    }
+    if ((strcmp(argv[4], "T")==0) && ((eccIDs.size()>1) || (argc!=6))) {
+        printf("Trace replay takes one ECC ID and one trace file\n");
+        exit(1);
+    }
+    if (!rateProfiles.empty() && (strcmp(argv[4], "S")!=0)) {
+        printf("Rate profiles are only supported with system simulation (S)\n");
+        exit(1);
+    }
+    if ((!recordLog.empty() || !replayLog.empty()) && (strcmp(argv[4], "S")!=0)) {
+        printf("Fault logs are only supported with system simulation (S)\n");
+        exit(1);
+    }
+    if ((firstRun>atol(argv[2])) && (strcmp(argv[4], "T")!=0)) {
+        printf("Invalid first run %ld (expected <= runCnt %s)\n", firstRun, argv[2]);
+        exit(1);
+    }
+    if (!recordLog.empty() && (!replayLog.empty() || (threadCount>1) || (shardCount>1) || (firstRun!=0) || resume)) {
+        printf("Recording a fault log takes a single thread, all runs from 0 and no replay\n");
+        exit(1);
+    }
+
     if (strcmp(argv[4], "S")==0) {
-        tester = new TesterSystem();
+        TesterSystem *system = new TesterSystem();
+        system->setImportanceSampling(isRate, isBias);
+        system->setSkipEmpty(skipEmpty);
+        system->setRetireSweep(retireThresholds);
+        system->setRecordLog(recordLog);
+        system->setReplayLog(replayLog);
+        for (size_t i=0; i<rateProfiles.size(); i++) {
+            system->addRateProfile(rateProfiles[i].first, rateProfiles[i].second);
+        }
+        tester = system;
         scrubber = new PeriodicScrubber(8);
+        tester->setSeed(atoi(argv[3]));
+        tester->setParallel(threadCount, buildWorkerSetup, eccIDs[0]);
+        tester->setReplayRun(replayRun);
+        tester->setCheckpoint(checkpointInterval, resume);
+        tester->setShard(shardID, shardCount, firstRun);
+        tester->setPrecision(relCI, confidence, ciMetrics);
 
         string faults[argc-5];
         for (int i=5; i<argc; i++) {
@@ -738,9 +929,43 @@ int main(int argc, char **argv)
         tester->test(dg, ecc, scrubber, atol(argv[2]), filePrefix, argc-5, faults);
         delete tester;
         delete scrubber;
+        for (size_t i=0; i<rateProfiles.size(); i++) {
+            delete rateProfiles[i].second;
+        }
+    } else if (strcmp(argv[4], "T")==0) {
+        tester = new TesterTrace();
+        scrubber = new PeriodicScrubber(8);
+        tester->setSeed(atoi(argv[3]));
+        tester->setReplayRun(replayRun);
+
+        string faults[1] = {string(argv[5])};
+        tester->test(dg, ecc, scrubber, atol(argv[2]), filePrefix, 1, faults);
+        delete tester;
+        delete scrubber;
     } else {
-        tester = new TesterScenario();
+        TesterScenario *scenario = new TesterScenario();
+        for (size_t i=1; i<eccIDs.size(); i++) {
+            char schemePrefix[256];
+            DomainGroup *schemeDG = NULL;
+            ECC *schemeECC = NULL;
+            buildSetup(eccIDs[i], argv[3], &schemeDG, &schemeECC, schemePrefix);
+            FaultDomain *fd = dg->getFD(), *schemeFD = schemeDG->getFD();
+            if ((fd->getChipWidth()!=schemeFD->getChipWidth()) || (fd->getChipCount()!=schemeFD->getChipCount())
+             || (fd->getBeatHeight()!=schemeFD->getBeatHeight()) || (fd->ranksPerDomain!=schemeFD->ranksPerDomain)) {
+                printf("%s has a different geometry from %s\n", schemePrefix, filePrefix);
+                exit(1);
+            }
+            delete schemeDG;
+            scenario->addScheme(eccIDs[i], schemeECC, schemePrefix);
+        }
+        tester = scenario;
         scrubber = new NoScrubber();
+        tester->setSeed(atoi(argv[3]));
+        tester->setParallel(threadCount, buildWorkerSetup, eccIDs[0]);
+        tester->setReplayRun(replayRun);
+        tester->setCheckpoint(checkpointInterval, resume);
+        tester->setShard(shardID, shardCount, firstRun);
+        tester->setPrecision(relCI, confidence, ciMetrics);
 
         string faults[argc-4];
         for (int i=4; i<argc; i++) {